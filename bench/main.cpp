@@ -0,0 +1,468 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   main.cpp                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:23:43 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// Headless benchmark suite of the MacroLibX
+// Every scenario is set up, run for some warmup frames and then measured for
+// a number of repetitions. Results are written as JSON to stdout or to the
+// file given with --output. With --check-allocations the run fails if a
+// steady state scenario allocated anything once warmed up.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include "../includes/mlx.h"
+
+static std::atomic<std::uint64_t> __allocations{0};
+static std::atomic<std::uint64_t> __allocated_bytes{0};
+
+// counts every C++ allocation of the process, the library ones included
+void* operator new(std::size_t size)
+{
+	__allocations.fetch_add(1, std::memory_order_relaxed);
+	__allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+	if(void* ptr = std::malloc(size == 0 ? 1 : size))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr int WIDTH = 800;
+	constexpr int HEIGHT = 600;
+
+	struct Options
+	{
+		std::string output;
+		std::string filter;
+		std::string image = "example/42_logo.png";
+		int warmup = 30;
+		int frames = 200;
+		int reps = 5;
+		bool headless = true;
+		bool check_allocations = false;
+	};
+
+	struct Bench;
+
+	struct Scenario
+	{
+		const char* name;
+		std::size_t ops_per_frame;
+		void (*setup)(Bench&);
+		void (*frame)(Bench&);
+		bool steady; // puts the same kind of work every frame, no allocation is expected once warm
+	};
+
+	struct Bench
+	{
+		Options options;
+		std::vector<Scenario> scenarios;
+		std::vector<void*> windows;
+		std::vector<void*> targets; // images rendered to by the headless windows
+		std::vector<void*> images;
+		std::vector<std::vector<double>> times; // frame times of each repetition, in milliseconds
+		std::string json;
+		Clock::time_point last;
+		std::uint64_t allocations = 0;
+		std::uint64_t allocated_bytes = 0;
+		std::uint64_t uploaded_bytes = 0;
+		std::vector<double> gpu_times; // GPU time of the measured frames of the first window
+		std::size_t scenario = 0;
+		int frame = 0;
+		bool skipped = false;
+		int failures = 0;
+		void* mlx = nullptr;
+	};
+
+	void* openWindow(Bench& b, int w, int h)
+	{
+		if(!b.options.headless)
+			return b.windows.emplace_back(mlx_new_window(b.mlx, w, h, "MacroLibX bench"));
+		void* target = b.targets.emplace_back(mlx_new_image(b.mlx, w, h));
+		return b.windows.emplace_back(mlx_new_window(b.mlx, w, h, static_cast<const char*>(target)));
+	}
+
+	void releaseAll(Bench& b)
+	{
+		for(void* win : b.windows)
+			mlx_destroy_window(b.mlx, win);
+		for(void* img : b.targets)
+			mlx_destroy_image(b.mlx, img);
+		for(void* img : b.images)
+			mlx_destroy_image(b.mlx, img);
+		b.windows.clear();
+		b.targets.clear();
+		b.images.clear();
+	}
+
+	void* newFilledImage(Bench& b, int w, int h, int color)
+	{
+		void* img = mlx_new_image(b.mlx, w, h);
+		for(int y = 0; y < h; y++)
+		{
+			for(int x = 0; x < w; x++)
+				mlx_set_image_pixel(b.mlx, img, x, y, color);
+		}
+		return img;
+	}
+
+	/* Scenarios */
+
+	void setupWindow(Bench& b) { openWindow(b, WIDTH, HEIGHT); }
+
+	void setupSprite(Bench& b)
+	{
+		openWindow(b, WIDTH, HEIGHT);
+		b.images.push_back(newFilledImage(b, 16, 16, 0xFF20A0FF));
+	}
+
+	void pixelPutFill(Bench& b)
+	{
+		mlx_clear_window(b.mlx, b.windows[0]);
+		int color = 0xFF000000 | (b.frame * 0x010203 & 0xFFFFFF);
+		for(int y = 0; y < 400; y++)
+		{
+			for(int x = 0; x < 400; x++)
+				mlx_pixel_put(b.mlx, b.windows[0], x, y, color);
+		}
+	}
+
+	void setupImageFill(Bench& b)
+	{
+		openWindow(b, WIDTH, HEIGHT);
+		b.images.push_back(mlx_new_image(b.mlx, 400, 400));
+	}
+
+	void setImagePixelFill(Bench& b)
+	{
+		int color = 0xFF000000 | (b.frame * 0x030201 & 0xFFFFFF);
+		for(int y = 0; y < 400; y++)
+		{
+			for(int x = 0; x < 400; x++)
+				mlx_set_image_pixel(b.mlx, b.images[0], x, y, color);
+		}
+		mlx_clear_window(b.mlx, b.windows[0]);
+		mlx_put_image_to_window(b.mlx, b.windows[0], b.images[0], 0, 0);
+	}
+
+	void spritePut(Bench& b)
+	{
+		mlx_clear_window(b.mlx, b.windows[0]);
+		for(int i = 0; i < 10000; i++)
+			mlx_put_image_to_window(b.mlx, b.windows[0], b.images[0], (i * 37 + b.frame) % (WIDTH - 16), (i * 53) % (HEIGHT - 16));
+	}
+
+	// the same sprites are put again every frame without clearing the window
+	void spriteReput(Bench& b)
+	{
+		for(int i = 0; i < 10000; i++)
+			mlx_put_image_to_window(b.mlx, b.windows[0], b.images[0], (i * 37) % (WIDTH - 16), (i * 53) % (HEIGHT - 16));
+	}
+
+	void stringPut(Bench& b)
+	{
+		mlx_clear_window(b.mlx, b.windows[0]);
+		char text[32];
+		for(int i = 0; i < 1000; i++)
+		{
+			std::snprintf(text, sizeof(text), "mlx bench %d", i);
+			mlx_string_put(b.mlx, b.windows[0], (i * 37) % (WIDTH - 100), 20 + (i * 53) % (HEIGHT - 20), 0xFFFFFFFF, text);
+		}
+	}
+
+	void setupImageLoad(Bench& b)
+	{
+		openWindow(b, WIDTH, HEIGHT);
+		int w;
+		int h;
+		void* img = mlx_png_file_to_image(b.mlx, const_cast<char*>(b.options.image.c_str()), &w, &h);
+		if(img == nullptr)
+		{
+			std::fprintf(stderr, "bench: cannot load '%s', image_load is skipped\n", b.options.image.c_str());
+			b.skipped = true;
+			return;
+		}
+		mlx_destroy_image(b.mlx, img);
+	}
+
+	void imageLoad(Bench& b)
+	{
+		if(b.skipped)
+			return;
+		int w;
+		int h;
+		for(int i = 0; i < 8; i++)
+		{
+			void* img = mlx_png_file_to_image(b.mlx, const_cast<char*>(b.options.image.c_str()), &w, &h);
+			mlx_destroy_image(b.mlx, img);
+		}
+	}
+
+	void createDestroyChurn(Bench& b)
+	{
+		for(int i = 0; i < 64; i++)
+		{
+			void* img = mlx_new_image(b.mlx, 64, 64);
+			mlx_set_image_pixel(b.mlx, img, i, i, 0xFFFFFFFF);
+			mlx_destroy_image(b.mlx, img);
+		}
+	}
+
+	// the cost of a call must not depend on the count of living images
+	template<int N>
+	void setupHandles(Bench& b)
+	{
+		openWindow(b, WIDTH, HEIGHT);
+		for(int i = 0; i < N; i++)
+			b.images.push_back(mlx_new_image(b.mlx, 8, 8));
+	}
+
+	void handleScaling(Bench& b)
+	{
+		std::size_t count = b.images.size();
+		for(int i = 0; i < 100000; i++)
+			mlx_set_image_pixel(b.mlx, b.images[(static_cast<std::size_t>(i) * 7919) % count], i & 7, (i >> 3) & 7, 0xFF000000 | i);
+	}
+
+	void setupMultiWindow(Bench& b)
+	{
+		for(int i = 0; i < 4; i++)
+			openWindow(b, 400, 300);
+		b.images.push_back(newFilledImage(b, 16, 16, 0xFFFF8020));
+	}
+
+	void multiWindow(Bench& b)
+	{
+		for(void* win : b.windows)
+		{
+			mlx_clear_window(b.mlx, win);
+			for(int i = 0; i < 1000; i++)
+				mlx_put_image_to_window(b.mlx, win, b.images[0], (i * 37 + b.frame) % 384, (i * 53) % 284);
+		}
+	}
+
+	/* Results */
+
+	double percentile(std::vector<double> values, double p)
+	{
+		if(values.empty())
+			return 0.0;
+		std::sort(values.begin(), values.end());
+		std::size_t index = static_cast<std::size_t>(p * (values.size() - 1) + 0.5);
+		return values[std::min(index, values.size() - 1)];
+	}
+
+	void appendResults(Bench& b, const Scenario& s)
+	{
+		std::vector<double> all;
+		std::vector<double> fps;
+		for(const std::vector<double>& rep : b.times)
+		{
+			double total = 0.0;
+			for(double t : rep)
+				total += t;
+			fps.push_back(total > 0.0 ? rep.size() * 1000.0 / total : 0.0);
+			all.insert(all.end(), rep.begin(), rep.end());
+		}
+		std::size_t measured = std::max<std::size_t>(all.size(), 1);
+
+		char buffer[1024];
+		std::snprintf(buffer, sizeof(buffer),
+			"%s\n\t\t{\n"
+			"\t\t\t\"name\": \"%s\",\n"
+			"\t\t\t\"skipped\": %s,\n"
+			"\t\t\t\"ops_per_frame\": %zu,\n"
+			"\t\t\t\"fps\": %.2f,\n"
+			"\t\t\t\"frame_time_ms\": { \"p50\": %.4f, \"p99\": %.4f, \"min\": %.4f, \"max\": %.4f },\n"
+			"\t\t\t\"steady_state\": %s,\n"
+			"\t\t\t\"allocations_per_frame\": %.2f,\n"
+			"\t\t\t\"allocated_bytes_per_frame\": %.2f,\n"
+			"\t\t\t\"uploaded_bytes_per_frame\": %.2f,\n"
+			"\t\t\t\"gpu_time_ms\": { \"p50\": %.4f, \"p99\": %.4f },\n"
+			"\t\t\t\"fps_per_repetition\": [",
+			b.scenario == 0 ? "" : ",", s.name, b.skipped ? "true" : "false", s.ops_per_frame, percentile(fps, 0.5),
+			percentile(all, 0.5), percentile(all, 0.99), percentile(all, 0.0), percentile(all, 1.0), s.steady ? "true" : "false",
+			static_cast<double>(b.allocations) / measured, static_cast<double>(b.allocated_bytes) / measured,
+			static_cast<double>(b.uploaded_bytes) / measured, percentile(b.gpu_times, 0.5), percentile(b.gpu_times, 0.99));
+		b.json += buffer;
+		for(std::size_t i = 0; i < fps.size(); i++)
+		{
+			std::snprintf(buffer, sizeof(buffer), "%s%.2f", i == 0 ? " " : ", ", fps[i]);
+			b.json += buffer;
+		}
+		b.json += " ]\n\t\t}";
+	}
+
+	int update(void* param)
+	{
+		Bench& b = *static_cast<Bench*>(param);
+		Clock::time_point now = Clock::now();
+		int total = b.options.warmup + b.options.frames * b.options.reps;
+
+		// the time since the last call covers the work and the rendering of the previous frame
+		if(b.frame > b.options.warmup && b.scenario < b.scenarios.size())
+		{
+			b.times[(b.frame - 1 - b.options.warmup) / b.options.frames].push_back(std::chrono::duration<double, std::milli>(now - b.last).count());
+			for(std::size_t i = 0; i < b.windows.size(); i++)
+			{
+				mlx_frame_stats stats;
+				if(mlx_get_frame_stats(b.mlx, b.windows[i], &stats) != 0)
+					continue;
+				b.uploaded_bytes += stats.uploaded_bytes;
+				if(i == 0)
+					b.gpu_times.push_back(stats.gpu.p50 < 0.0 ? -1.0 : stats.gpu.p50);
+			}
+		}
+		b.last = now;
+
+		if(b.scenario < b.scenarios.size() && b.frame == total)
+		{
+			b.allocations = __allocations.load() - b.allocations;
+			b.allocated_bytes = __allocated_bytes.load() - b.allocated_bytes;
+			appendResults(b, b.scenarios[b.scenario]);
+			if(b.options.check_allocations && b.scenarios[b.scenario].steady && !b.skipped && b.allocations != 0)
+			{
+				std::fprintf(stderr, "bench: %s allocated %llu times in steady state\n", b.scenarios[b.scenario].name, static_cast<unsigned long long>(b.allocations));
+				b.failures++;
+			}
+			releaseAll(b);
+			std::fprintf(stderr, "bench: %s done\n", b.scenarios[b.scenario].name);
+			b.scenario++;
+			b.frame = 0;
+		}
+		if(b.scenario == b.scenarios.size())
+		{
+			mlx_loop_end(b.mlx);
+			return 0;
+		}
+
+		const Scenario& s = b.scenarios[b.scenario];
+		if(b.frame == 0)
+		{
+			b.skipped = false;
+			b.times.assign(b.options.reps, {});
+			for(std::vector<double>& rep : b.times)
+				rep.reserve(b.options.frames); // the bench must not count its own allocations
+			b.gpu_times.reserve(static_cast<std::size_t>(b.options.frames) * b.options.reps);
+			s.setup(b);
+		}
+		if(b.frame == b.options.warmup)
+		{
+			b.allocations = __allocations.load();
+			b.allocated_bytes = __allocated_bytes.load();
+			b.uploaded_bytes = 0;
+			b.gpu_times.clear();
+			for(void* win : b.windows)
+				mlx_set_frame_stats_window(b.mlx, win, 1); // the last GPU time only
+		}
+		s.frame(b);
+		b.frame++;
+		return 0;
+	}
+
+	bool parseOptions(int argc, char** argv, Options& options)
+	{
+		for(int i = 1; i < argc; i++)
+		{
+			std::string arg = argv[i];
+			bool has_value = (i + 1 < argc);
+			if(arg == "--window")
+				options.headless = false;
+			else if(arg == "--output" && has_value)
+				options.output = argv[++i];
+			else if(arg == "--filter" && has_value)
+				options.filter = argv[++i];
+			else if(arg == "--image" && has_value)
+				options.image = argv[++i];
+			else if(arg == "--warmup" && has_value)
+				options.warmup = std::max(std::atoi(argv[++i]), 1);
+			else if(arg == "--frames" && has_value)
+				options.frames = std::max(std::atoi(argv[++i]), 1);
+			else if(arg == "--reps" && has_value)
+				options.reps = std::max(std::atoi(argv[++i]), 1);
+			else if(arg == "--check-allocations")
+				options.check_allocations = true;
+			else
+			{
+				std::fprintf(stderr, "usage: %s [--window] [--output file] [--filter name] [--image file] [--warmup n] [--frames n] [--reps n] [--check-allocations]\n", argv[0]);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Bench b;
+	if(!parseOptions(argc, argv, b.options))
+		return 1;
+
+	const Scenario scenarios[] = {
+		{ "pixel_put_fill", 400 * 400, setupWindow, pixelPutFill, true },
+		{ "set_image_pixel_fill", 400 * 400, setupImageFill, setImagePixelFill, true },
+		{ "sprite_put_10000", 10000, setupSprite, spritePut, true },
+		{ "sprite_reput_10000", 10000, setupSprite, spriteReput, true },
+		{ "string_put_1000", 1000, setupWindow, stringPut, true },
+		{ "image_load", 8, setupImageLoad, imageLoad, false },
+		{ "create_destroy_churn", 64, setupWindow, createDestroyChurn, false },
+		{ "handle_scaling_100", 100000, setupHandles<100>, handleScaling, true },
+		{ "handle_scaling_1000", 100000, setupHandles<1000>, handleScaling, true },
+		{ "handle_scaling_10000", 100000, setupHandles<10000>, handleScaling, true },
+		{ "multi_window_4", 4000, setupMultiWindow, multiWindow, true },
+	};
+	for(const Scenario& s : scenarios)
+	{
+		if(b.options.filter.empty() || std::strstr(s.name, b.options.filter.c_str()) != nullptr)
+			b.scenarios.push_back(s);
+	}
+
+	b.mlx = (b.options.headless ? mlx_init_headless() : mlx_init());
+	if(b.mlx == nullptr)
+		return 1;
+
+	char header[256];
+	std::snprintf(header, sizeof(header), "{\n\t\"headless\": %s,\n\t\"warmup_frames\": %d,\n\t\"frames\": %d,\n\t\"repetitions\": %d,\n\t\"scenarios\": [",
+		b.options.headless ? "true" : "false", b.options.warmup, b.options.frames, b.options.reps);
+	b.json = header;
+
+	mlx_loop_hook(b.mlx, update, &b);
+	mlx_loop(b.mlx);
+	releaseAll(b);
+	mlx_destroy_display(b.mlx);
+
+	b.json += "\n\t]\n}\n";
+	FILE* out = (b.options.output.empty() ? stdout : std::fopen(b.options.output.c_str(), "w"));
+	if(out == nullptr)
+	{
+		std::fprintf(stderr, "bench: cannot open '%s'\n", b.options.output.c_str());
+		return 1;
+	}
+	std::fputs(b.json.c_str(), out);
+	if(out != stdout)
+		std::fclose(out);
+	return (b.failures == 0 ? 0 : 1);
+}
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 16:56:35 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/18 14:36:12 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:36:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -32,6 +32,55 @@ typedef enum
 	MLX_WINDOW_EVENT = 5
 } mlx_event_type;
 
+typedef enum
+{
+	MLX_CAPTURE_RAW = 0, // every frame as RGBA8 bytes appended to a single file
+	MLX_CAPTURE_PNG = 1, // one png file per frame
+	MLX_CAPTURE_Y4M = 2  // YUV4MPEG2 video stream
+} mlx_capture_format;
+
+typedef enum
+{
+	MLX_GPU_TIME_FRAME = 0,
+	MLX_GPU_TIME_UPLOADS = 1,
+	MLX_GPU_TIME_IMAGES = 2,
+	MLX_GPU_TIME_TEXTS = 3,
+	MLX_GPU_TIME_PIXEL_PUT = 4,
+	MLX_GPU_TIME_OTHER = 5 // clearing, readbacks, ...
+} mlx_gpu_time;
+
+typedef enum
+{
+	MLX_PRESENT_IMMEDIATE = 0,		// no vsync, lowest latency, may tear (default)
+	MLX_PRESENT_MAILBOX = 1,		// vsync without blocking, the newest frame replaces the queued one
+	MLX_PRESENT_FIFO = 2,			// vsync, always supported, saves power
+	MLX_PRESENT_FIFO_RELAXED = 3	// vsync unless a frame is late, then it tears
+} mlx_present_mode;
+
+typedef struct
+{
+	double average;
+	double p50;
+	double p95;
+	double p99;
+} mlx_time_stats; // milliseconds
+
+typedef struct
+{
+	mlx_time_stats frame;	// CPU time between two frames of the window
+	mlx_time_stats hook;	// loop hook
+	mlx_time_stats record;	// recording of the frame commands
+	mlx_time_stats submit;	// submission and presentation
+	mlx_time_stats gpu;		// GPU time of the frames, negative if not supported
+	unsigned int samples;	// frames the statistics are computed on
+	unsigned long long dropped_frames;	// frames the loop missed because of the FPS goal
+	unsigned long long skipped_frames;	// frames the window could not render (e.g. while being resized)
+	unsigned long long uploaded_bytes;	// image data sent to the GPU by the last frame
+	unsigned int draw_calls;			// of the last frame
+	unsigned int descriptor_binds;		// of the last frame
+	mlx_time_stats pacing;	// lateness of the loop wake ups against the FPS goal deadlines, zero if not capped
+} mlx_frame_stats;
+
 
 /**
  * @brief			Initializes the MLX internal application
@@ -41,6 +90,18 @@ typedef enum
 MLX_API void* mlx_init();
 
 
+/**
+ * @brief			Initializes the MLX internal application without any display
+ *
+ * @return (void*)	An opaque pointer to the internal MLX application or NULL (0x0) in case of error
+ *
+ * Works on machines without display nor GPU as long as a Vulkan driver is
+ * available (software ones like lavapipe included). No window can be created,
+ * rendering is done into images given to `mlx_new_window` instead of a title.
+ */
+MLX_API void* mlx_init_headless();
+
+
 /**
  * @brief			Creates a new window
  *
@@ -213,6 +274,194 @@ MLX_API int mlx_get_image_pixel(void* mlx, void* img, int x, int y);
 MLX_API void mlx_set_image_pixel(void* mlx, void* img, int x, int y, int color);
 
 
+/**
+ * @brief	Set a whole rectangle of pixels in an image in one call
+ *
+ * @param mlx				Internal MLX application
+ * @param img				Internal image
+ * @param x					X coordinate of the top left corner of the region
+ * @param y					Y coordinate of the top left corner of the region
+ * @param w					Width of the region
+ * @param h					Height of the region
+ * @param pixels			Tightly packed rows of w * h colors, same format as mlx_set_image_pixel
+ *
+ * @return (void)
+ *
+ * Parts of the region that are out of the image are ignored.
+ * The image is sent to the GPU at the next render, like with mlx_set_image_pixel.
+ */
+MLX_API void mlx_set_image_region(void* mlx, void* img, int x, int y, int w, int h, const int* pixels);
+
+
+/**
+ * @brief	Get a whole rectangle of pixels from an image in one call
+ *
+ * @param mlx				Internal MLX application
+ * @param img				Internal image
+ * @param x					X coordinate of the top left corner of the region
+ * @param y					Y coordinate of the top left corner of the region
+ * @param w					Width of the region
+ * @param h					Height of the region
+ * @param pixels			Buffer of at least w * h ints filled with tightly packed rows of colors,
+ * 							same format as mlx_get_image_pixel
+ *
+ * @return (void)
+ *
+ * Parts of the region that are out of the image are left untouched in the buffer.
+ */
+MLX_API void mlx_get_image_region(void* mlx, void* img, int x, int y, int w, int h, int* pixels);
+
+
+/**
+ * @brief			Reads the content of a window back without stalling the rendering
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param callback	Called with the pixels of the window, same format as mlx_get_image_pixel,
+ * 					as tightly packed rows of width ints
+ * @param param		Param given to the callback
+ *
+ * @return (int)	0 if the read back has been scheduled, -1 otherwise
+ *
+ * The copy is made at the end of the next rendered frame and the callback is
+ * called by the loop one or two frames later, once the GPU is done with it.
+ * The pixels are only valid during the callback. The callback must not destroy
+ * the window it reads from.
+ */
+MLX_API int mlx_read_window_pixels(void* mlx, void* win, void (*callback)(const int* pixels, int width, int height, void* param), void* param);
+
+
+/**
+ * @brief			Reads the content of an image back from the GPU without stalling the rendering
+ *
+ * @param mlx		Internal MLX application
+ * @param img		Internal image
+ * @param callback	Called with the pixels of the image, same format as mlx_get_image_pixel,
+ * 					as tightly packed rows of width ints
+ * @param param		Param given to the callback
+ *
+ * @return (int)	0 if the read back has been scheduled, -1 otherwise
+ *
+ * Gives what the GPU holds, e.g. what has been rendered to an image used as a window.
+ * Needs at least one window to be rendering as the copy is made during its next frame.
+ * Destroying the image before the copy is made cancels the read back.
+ */
+MLX_API int mlx_read_image_async(void* mlx, void* img, void (*callback)(const int* pixels, int width, int height, void* param), void* param);
+
+
+/**
+ * @brief			Starts writing every rendered frame of a window to disk
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param path		File to write, png captures write <path without extension>_<frame number>.png files
+ * @param format	Format of the capture
+ * @param block		If not 0 the loop waits for the encoder when it is late, otherwise frames are dropped
+ *
+ * @return (int)	0 on success, -1 otherwise
+ *
+ * Frames are read back asynchronously and encoded by a background thread.
+ * Y4M captures use the FPS goal as frame rate (60 if none has been set).
+ * Starting a capture on a window that is already capturing stops the previous one.
+ */
+MLX_API int mlx_capture_start(void* mlx, void* win, const char* path, mlx_capture_format format, int block);
+
+
+/**
+ * @brief			Stops the capture of a window and waits for the queued frames to be written
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ *
+ * @return (int)	The number of frames that were dropped, -1 on error
+ */
+MLX_API int mlx_capture_stop(void* mlx, void* win);
+
+
+/**
+ * @brief			Gets the time the GPU spent on the last completed frame of a window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param category	Part of the frame to get, MLX_GPU_TIME_FRAME for all of it
+ *
+ * @return (double)	Time in milliseconds, negative if the GPU does not support timestamps
+ *
+ * Times are measured with timestamp queries and read one or two frames later,
+ * without ever waiting for the GPU.
+ */
+MLX_API double mlx_get_gpu_time(void* mlx, void* win, mlx_gpu_time category);
+
+
+/**
+ * @brief			Gets the timing statistics of the last frames of a window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param stats		Filled with the statistics
+ *
+ * @return (int)	0 on success, -1 otherwise
+ *
+ * Times are averages and percentiles over the last frames (120 by default,
+ * see mlx_set_frame_stats_window). Available without the profiler build.
+ */
+MLX_API int mlx_get_frame_stats(void* mlx, void* win, mlx_frame_stats* stats);
+
+
+/**
+ * @brief			Sets over how many frames the statistics of a window are computed
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param frames	Count of frames, between 1 and 8192
+ *
+ * @return (int)	0 on success, -1 otherwise
+ */
+MLX_API int mlx_set_frame_stats_window(void* mlx, void* win, int frames);
+
+
+/**
+ * @brief			Sets how the frames of a window are presented
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param mode		Present mode to use
+ *
+ * @return (int)	0 on success, -1 otherwise
+ *
+ * The swapchain of the window is recreated after the next presented frame.
+ * If the mode is not supported by the surface the closest one is used
+ * (immediate and mailbox fall back on each other, then on FIFO).
+ */
+MLX_API int mlx_set_present_mode(void* mlx, void* win, mlx_present_mode mode);
+
+
+/**
+ * @brief			Gets the present mode used by a window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ *
+ * @return (int)	The mlx_present_mode in use, -1 on error
+ */
+MLX_API int mlx_get_present_mode(void* mlx, void* win);
+
+
+/**
+ * @brief			Sets how many images the swapchain of a window should hold
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param count		Images wanted, 0 to let the library choose
+ *
+ * @return (int)	0 on success, -1 otherwise
+ *
+ * This is a hint clamped to what the surface supports, applied like mlx_set_present_mode.
+ * Fewer images lower the latency, more images smooth out irregular frames.
+ */
+MLX_API int mlx_set_swapchain_image_count(void* mlx, void* win, int count);
+
+
 /**
  * @brief			Put image to the given window
  *
@@ -227,6 +476,23 @@ MLX_API void mlx_set_image_pixel(void* mlx, void* img, int x, int y, int color);
 MLX_API int mlx_put_image_to_window(void* mlx, void* win, void* img, int x, int y);
 
 
+/**
+ * @brief			Put the same image many times to the given window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param img		Internal image
+ * @param xy		Array of count pairs of X and Y coordinates { x0, y0, x1, y1, ... }
+ * @param count		Number of copies of the image to put
+ *
+ * @return (int)	Always return 0
+ *
+ * Same as calling mlx_put_image_to_window for each position but all copies
+ * are checked once and are drawn together.
+ */
+MLX_API int mlx_put_image_batch(void* mlx, void* win, void* img, const int* xy, int count);
+
+
 /**
  * @brief			Destroys internal image
  *
@@ -251,6 +517,52 @@ MLX_API int mlx_destroy_image(void* mlx, void* img);
 MLX_API void* mlx_png_file_to_image(void* mlx, char* filename, int* width, int* height);
 
 
+/**
+ * @brief			Create a new image from png data in memory
+ *
+ * @param mlx		Internal MLX application
+ * @param data		Content of a png file
+ * @param size		Size of data in bytes
+ * @param width		Get the width of the image
+ * @param heigth	Get the height of the image
+ *
+ * @return (void*)	An opaque pointer to the internal image or NULL (0x0) in case of error
+ *
+ * The data is only read during the call, jpg and bmp data are accepted too.
+ */
+MLX_API void* mlx_png_memory_to_image(void* mlx, unsigned char* data, int size, int* width, int* height);
+
+
+/**
+ * @brief			Start loading a png file in the background
+ *
+ * @param mlx		Internal MLX application
+ * @param filename	Path to the png file
+ * @param callback	Function called by the MLX loop once the image is ready or failed to load (may be NULL)
+ * @param param		Param given to the callback
+ *
+ * @return (void*)	An opaque pointer to the internal image or NULL (0x0) in case of error
+ *
+ * The file is decoded by worker threads and uploaded by mlx_loop, which keeps
+ * rendering meanwhile. The image can already be put to a window, it is drawn
+ * once loaded. The callback gets the image and its size, or a size of 0 if
+ * the loading failed. The image must be destroyed with mlx_destroy_image
+ * in both cases.
+ */
+MLX_API void* mlx_png_file_to_image_async(void* mlx, char* filename, void (*callback)(void* img, int width, int height, void* param), void* param);
+
+
+/**
+ * @brief			Get the loading state of an image
+ *
+ * @param mlx		Internal MLX application
+ * @param img		Internal image
+ *
+ * @return (int)	1 if the image is ready, 0 if it is still loading, -1 if the loading failed
+ */
+MLX_API int mlx_image_is_ready(void* mlx, void* img);
+
+
 /**
  * @brief			Create a new image from a jpg file
  *
@@ -277,6 +589,23 @@ MLX_API void* mlx_jpg_file_to_image(void* mlx, char* filename, int* width, int*
 MLX_API void* mlx_bmp_file_to_image(void* mlx, char* filename, int* width, int* height);
 
 
+/**
+ * @brief			Enables or disables the image cache of the file loaders
+ *
+ * @param mlx		Internal MLX application
+ * @param enable	Non zero to enable the cache, 0 to disable it (disabled by default)
+ *
+ * @return (int)	Always return 0
+ *
+ * While enabled, loading a png, jpg or bmp file that did not change since it
+ * was last loaded shares the already decoded image instead of decoding it
+ * again. Each load still returns its own image: the first write into one of
+ * them gives it a private copy, the other loads are left untouched. Each load
+ * must still be paired with a call to mlx_destroy_image.
+ */
+MLX_API int mlx_set_image_cache(void* mlx, int enable);
+
+
 /**
  * @brief			Put text in given window
  *
@@ -317,6 +646,20 @@ MLX_API void mlx_set_font(void* mlx, void* win, char* filepath);
 MLX_API void mlx_set_font_scale(void* mlx, void* win, char* filepath, float scale);
 
 
+/**
+ * @brief			Loads a font from truetype data in memory to be used by `mlx_string_put`
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param data		Content of a ttf file, copied by the MLX
+ * @param size		Size of data in bytes
+ * @param scale		Scale to apply to the font
+ *
+ * @return (void)	
+ */
+MLX_API void mlx_font_memory(void* mlx, void* win, unsigned char* data, int size, float scale);
+
+
 /**
  * @brief			Clears the given window (resets all rendered data)
  *
@@ -364,6 +707,10 @@ MLX_API int mlx_get_screens_size(void* mlx, void* win, int* w, int* h);
 /**
  * @brief			Caps the FPS
  *
+ *					The loop sleeps until shortly before each frame deadline and waits
+ *					actively for the remainder, the precision reached is reported by
+ *					the `pacing` field of `mlx_get_frame_stats`.
+ *
  * @param mlx		Internal MLX application
  * @param fps		The FPS cap
  *
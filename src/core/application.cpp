@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 22:10:52 by maldavid          #+#    #+#             */
-/*   Updated: 2024/04/21 18:13:29 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:36:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,18 +15,22 @@
 #include <renderer/texts/font_library.h>
 #include <SDL2/SDL.h>
 #include <renderer/images/texture.h>
+#include <renderer/buffers/staging_ring.h>
 #include <renderer/core/render_core.h>
 #include <core/errors.h>
 #include <mlx_profile.h>
 #include <core/memory.h>
+#include <cstring>
+#include <utility>
+#include <chrono>
 
 namespace mlx::core
 {
 	static bool __drop_sdl_responsability = false;
-	Application::Application() : _fps(), _in(std::make_unique<Input>()) 
+	Application::Application(bool headless) : _fps(), _in(std::make_unique<Input>()), _headless(headless)
 	{
 		_fps.init();
-		__drop_sdl_responsability = SDL_WasInit(SDL_INIT_VIDEO);
+		__drop_sdl_responsability = SDL_WasInit(headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO);
 		if(__drop_sdl_responsability) // is case the mlx is running in a sandbox like MacroUnitTester where SDL is already init
 			return;
 		SDL_SetMemoryFunctions(MemManager::malloc, MemManager::calloc, MemManager::realloc, MemManager::free);
@@ -34,7 +38,8 @@ namespace mlx::core
 		/* Remove this comment if you want to prioritise Wayland over X11/XWayland, at your own risks */
 		//SDL_SetHint(SDL_HINT_VIDEODRIVER, "wayland,x11");
 
-		if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_TIMER) != 0)
+		// headless applications have no display to talk to, only the event queue and the timers are needed
+		if(SDL_Init((headless ? 0 : SDL_INIT_VIDEO) | SDL_INIT_EVENTS | SDL_INIT_TIMER) != 0)
 			error::report(e_kind::fatal_error, "SDL error : unable to init all subsystems : %s", SDL_GetError());
 	}
 
@@ -42,77 +47,455 @@ namespace mlx::core
 	{
 		while(_in->isRunning())
 		{
-			if(!_fps.update())
-				continue;
+			_fps.update();
 			_in->update();
+			uploadDecodedTextures();
 
 			if(_loop_hook)
-				_loop_hook(_param);
-
-			for(auto& gs : _graphics)
 			{
-				if(gs)
-					gs->render();
+				auto hook_begin = std::chrono::steady_clock::now();
+				_loop_hook(_param);
+				double hook_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hook_begin).count();
+				_graphics.forEach([=](GraphicsSupport& gs) { gs.getFrameStats().push(FrameMetric::hook, hook_time); });
 			}
+
+			_graphics.forEach([](GraphicsSupport& gs) { gs.render(); });
 		}
 
 		Render_Core::get().getSingleTimeCmdManager().updateSingleTimesCmdBuffersSubmitState();
 
-		for(auto& gs : _graphics)
+		_graphics.forEach([](GraphicsSupport& gs)
 		{
-			if(!gs)
-				continue;
 			for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-				gs->getRenderer().getCmdBuffer(i).waitForExecution();
-		}
+				gs.getRenderer().getCmdBuffer(i).waitForExecution();
+		});
 	}
 
 	void* Application::newTexture(int w, int h)
 	{
 		MLX_PROFILE_FUNCTION();
+		SlotMap<Texture>::Handle handle = _textures.emplace();
 		#ifdef DEBUG
-			_textures.emplace_front().create(nullptr, w, h, VK_FORMAT_R8G8B8A8_UNORM, "__mlx_unamed_user_texture");
+			_textures.get(handle)->create(nullptr, w, h, VK_FORMAT_R8G8B8A8_UNORM, "__mlx_unamed_user_texture");
 		#else
-			_textures.emplace_front().create(nullptr, w, h, VK_FORMAT_R8G8B8A8_UNORM, nullptr);
+			_textures.get(handle)->create(nullptr, w, h, VK_FORMAT_R8G8B8A8_UNORM, nullptr);
 		#endif
-		return &_textures.front();
+		return SlotMap<Texture>::toPointer(handle);
 	}
 
 	void* Application::newStbTexture(char* file, int* w, int* h)
 	{
 		MLX_PROFILE_FUNCTION();
-		_textures.emplace_front(stbTextureLoad(file, w, h));
-		return &_textures.front();
+		ImageCacheKey key;
+		if(!_image_cache.isEnabled() || !ImageCache::makeKey(file, key))
+		{
+			Texture texture = stbTextureLoad(file, w, h);
+			if(!texture.isInit())
+				return nullptr;
+			return SlotMap<Texture>::toPointer(_textures.emplace(std::move(texture)));
+		}
+
+		// every load gets its own handle, a view of the cached image that stays empty until it is written
+		SlotMap<Texture>::Handle shared;
+		if(_image_cache.acquire(key, shared))
+		{
+			Texture* texture = _textures.get(shared);
+			if(w != nullptr)
+				*w = texture->getWidth();
+			if(h != nullptr)
+				*h = texture->getHeight();
+		}
+		else
+		{
+			Texture texture = stbTextureLoad(file, w, h);
+			if(!texture.isInit())
+				return nullptr;
+			shared = _textures.emplace(std::move(texture));
+			_image_cache.insert(std::move(key), shared);
+		}
+		SlotMap<Texture>::Handle view = _textures.emplace();
+		_image_views.emplace(view, shared);
+		return SlotMap<Texture>::toPointer(view);
+	}
+
+	Texture* Application::getTexture(void* img) noexcept
+	{
+		auto it = _image_views.find(reinterpret_cast<SlotMap<Texture>::Handle>(img));
+		if(it != _image_views.end())
+			return _textures.get(it->second);
+		return _textures.get(img);
+	}
+
+	Texture* Application::getWritableTexture(void* img)
+	{
+		MLX_PROFILE_FUNCTION();
+		auto it = _image_views.find(reinterpret_cast<SlotMap<Texture>::Handle>(img));
+		if(it == _image_views.end())
+			return _textures.get(img);
+		Texture* shared = _textures.get(it->second);
+		if(!_image_cache.isShared(it->second))
+		{
+			// only this load sees the image, it can be written in place as long as later loads do not get it
+			_image_cache.forget(it->second);
+			return shared;
+		}
+		// copy on write, the view gets a private image and drops its reference to the shared one
+		Texture* texture = _textures.get(img);
+		#ifdef DEBUG
+			texture->createCopy(*shared, "__mlx_cached_image_copy");
+		#else
+			texture->createCopy(*shared, nullptr);
+		#endif
+		_image_cache.release(it->second);
+		_image_views.erase(it);
+		return texture;
+	}
+
+	void* Application::newStbTextureFromMemory(const std::uint8_t* data, std::size_t size, int* w, int* h)
+	{
+		MLX_PROFILE_FUNCTION();
+		Texture texture = stbTextureLoadFromMemory(data, size, w, h, "__mlx_memory_image");
+		if(!texture.isInit())
+			return nullptr;
+		return SlotMap<Texture>::toPointer(_textures.emplace(std::move(texture)));
+	}
+
+	void* Application::newStbTextureAsync(char* file, void (*callback)(void*, int, int, void*), void* param)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!_decoder.isInit())
+			_decoder.init();
+		// the handle is given right away, the texture stays uninitialized until its upload
+		SlotMap<Texture>::Handle handle = _textures.emplace();
+		_async_loads.emplace(handle, AsyncLoad{ file, callback, param });
+		_decoder.request(handle, file);
+		return SlotMap<Texture>::toPointer(handle);
+	}
+
+	int Application::getTextureLoadState(void* img)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_IMAGE_PTR(img, return -1);
+		uploadDecodedTextures();
+		auto it = _async_loads.find(reinterpret_cast<SlotMap<Texture>::Handle>(img));
+		if(it != _async_loads.end())
+			return it->second.failed ? -1 : 0;
+		return getTexture(img)->isInit() ? 1 : -1;
+	}
+
+	void Application::uploadDecodedTextures()
+	{
+		if(!_decoder.isInit() || _uploading_decoded)
+			return;
+		MLX_PROFILE_FUNCTION();
+		_decoder.collect(_decoded_images);
+		if(_decoded_images.empty())
+			return;
+		_uploading_decoded = true;
+		// moved out so the callbacks below cannot touch the list being walked
+		std::vector<DecodedImage> decoded_images;
+		std::swap(decoded_images, _decoded_images);
+
+		// every image decoded since the last call is uploaded from one staging allocation in a single submission
+		std::size_t size = 0;
+		for(const DecodedImage& image : decoded_images)
+		{
+			if(image.pixels && _async_loads.count(image.id) != 0)
+				size += static_cast<std::size_t>(image.width) * image.height * 4;
+		}
+
+		StagingRing::Allocation staging;
+		CmdBuffer* cmd = nullptr;
+		std::uint8_t* map = nullptr;
+		if(size != 0)
+		{
+			staging = StagingRing::get().allocate(size);
+			map = static_cast<std::uint8_t*>(staging.data);
+			cmd = &Render_Core::get().getSingleTimeCmdBuffer();
+			cmd->beginRecord();
+		}
+
+		VkDeviceSize offset = 0;
+		for(DecodedImage& image : decoded_images)
+		{
+			auto it = _async_loads.find(image.id);
+			if(it == _async_loads.end()) // destroyed while being decoded
+				continue;
+			if(!image.pixels)
+			{
+				it->second.failed = true;
+				continue;
+			}
+			std::size_t image_size = static_cast<std::size_t>(image.width) * image.height * 4;
+			std::memcpy(map + offset, image.pixels.get(), image_size);
+			#ifdef DEBUG
+				_textures.get(image.id)->createFromBuffer(*staging.buffer, staging.offset + offset, image.width, image.height, VK_FORMAT_R8G8B8A8_UNORM, it->second.file.c_str(), *cmd);
+			#else
+				_textures.get(image.id)->createFromBuffer(*staging.buffer, staging.offset + offset, image.width, image.height, VK_FORMAT_R8G8B8A8_UNORM, nullptr, *cmd);
+			#endif
+			offset += image_size;
+		}
+
+		if(cmd != nullptr)
+		{
+			StagingRing::get().flush(staging);
+			cmd->endRecord();
+			cmd->submitIdle(false); // later frames are ordered after this submission on the graphics queue
+			StagingRing::get().release(cmd->getSubmissionSerial());
+		}
+
+		for(DecodedImage& image : decoded_images)
+		{
+			auto it = _async_loads.find(image.id);
+			if(it == _async_loads.end())
+				continue;
+			AsyncLoad load = it->second;
+			if(!load.failed)
+				_async_loads.erase(it);
+			if(load.callback != nullptr)
+				load.callback(SlotMap<Texture>::toPointer(image.id), load.failed ? 0 : image.width, load.failed ? 0 : image.height, load.param);
+		}
+		decoded_images.clear();
+		if(_decoded_images.empty())
+			std::swap(decoded_images, _decoded_images); // keeps the capacity for the next uploads
+		_uploading_decoded = false;
 	}
 
 	void Application::destroyTexture(void* ptr)
 	{
 		MLX_PROFILE_FUNCTION();
-		vkDeviceWaitIdle(Render_Core::get().getDevice().get()); // TODO : synchronize with another method than waiting for GPU to be idle
 		if(ptr == nullptr)
 		{
 			core::error::report(e_kind::error, "invalid image ptr (NULL)");
 			return;
 		}
 
-		auto it = std::find_if(_textures.begin(), _textures.end(), [=](const Texture& texture) { return &texture == ptr; });
-		if(it == _textures.end())
+		Texture* texture = _textures.get(ptr);
+		if(texture == nullptr)
 		{
 			core::error::report(e_kind::error, "invalid image ptr");
 			return;
 		}
-		Texture* texture = static_cast<Texture*>(ptr);
+		if(auto view = _image_views.find(reinterpret_cast<SlotMap<Texture>::Handle>(ptr)); view != _image_views.end())
+		{
+			SlotMap<Texture>::Handle shared = view->second;
+			_image_views.erase(view);
+			_textures.erase(ptr);
+			if(_image_cache.release(shared)) // still seen by other loads of the same file
+				return;
+			ptr = SlotMap<Texture>::toPointer(shared);
+			texture = _textures.get(shared);
+		}
+		if(_async_loads.erase(reinterpret_cast<SlotMap<Texture>::Handle>(ptr)) != 0 && !texture->isInit()) // still loading or failed to
+		{
+			_graphics.forEach([=](GraphicsSupport& gs) { gs.tryEraseTextureFromManager(texture); });
+			_textures.erase(ptr);
+			return;
+		}
 		if(!texture->isInit())
 			core::error::report(e_kind::error, "trying to destroy a texture that has already been destroyed");
 		else
 			texture->destroy();
-		for(auto& gs : _graphics)
-			gs->tryEraseTextureFromManager(texture);
-		_textures.erase(it);
+		_graphics.forEach([=](GraphicsSupport& gs)
+		{
+			gs.tryEraseTextureFromManager(texture);
+			gs.getRenderer().getReadbacks().forget(texture);
+		});
+		_textures.erase(ptr);
+	}
+
+	int Application::readGraphicsSupport(void* win, void (*callback)(const int*, int, int, void*), void* param)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(win == nullptr || _graphics.get(win) == nullptr)
+		{
+			error::report(e_kind::error, "invalid window ptr");
+			return -1;
+		}
+		Renderer& renderer = _graphics.get(win)->getRenderer();
+		if(_graphics.get(win)->hasWindow() && !renderer.getSwapChain().isReadable())
+		{
+			error::report(e_kind::error, "the window surface does not support being read back");
+			return -1;
+		}
+		renderer.getReadbacks().request(nullptr, [=](const std::uint32_t* pixels, std::uint32_t w, std::uint32_t h)
+		{
+			callback(reinterpret_cast<const int*>(pixels), static_cast<int>(w), static_cast<int>(h), param);
+		});
+		return 0;
+	}
+
+	int Application::readTextureAsync(void* img, void (*callback)(const int*, int, int, void*), void* param)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_IMAGE_PTR(img, return -1);
+		Texture* texture = getTexture(img);
+		if(!texture->isInit())
+		{
+			error::report(e_kind::error, "trying to read back an image that is not loaded");
+			return -1;
+		}
+		// the copy is recorded in the next frame of the first window found
+		Renderer* renderer = nullptr;
+		_graphics.forEach([&](GraphicsSupport& gs)
+		{
+			if(renderer == nullptr)
+				renderer = &gs.getRenderer();
+		});
+		if(renderer == nullptr)
+		{
+			error::report(e_kind::error, "reading an image back needs a window to be rendering");
+			return -1;
+		}
+		renderer->getReadbacks().request(texture, [=](const std::uint32_t* pixels, std::uint32_t w, std::uint32_t h)
+		{
+			callback(reinterpret_cast<const int*>(pixels), static_cast<int>(w), static_cast<int>(h), param);
+		});
+		return 0;
+	}
+
+	int Application::startCapture(void* win, const char* path, CaptureFormat format, bool block)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(win == nullptr || _graphics.get(win) == nullptr)
+		{
+			error::report(e_kind::error, "invalid window ptr");
+			return -1;
+		}
+		return _graphics.get(win)->startCapture(path, format, block, _fps.getMaxFPS()) ? 0 : -1;
+	}
+
+	int Application::stopCapture(void* win)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(win == nullptr || _graphics.get(win) == nullptr)
+		{
+			error::report(e_kind::error, "invalid window ptr");
+			return -1;
+		}
+		return static_cast<int>(_graphics.get(win)->stopCapture());
+	}
+
+	double Application::getGPUTime(void* win, int category)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(win == nullptr || _graphics.get(win) == nullptr)
+		{
+			error::report(e_kind::error, "invalid window ptr");
+			return -1.0;
+		}
+		FrameTimestamps& timestamps = _graphics.get(win)->getRenderer().getTimestamps();
+		if(category < 0)
+			return timestamps.getFrameTime();
+		return timestamps.getTime(static_cast<GPUTimeCategory>(category));
+	}
+
+	static void fillTimeStats(mlx_time_stats& out, const FrameStats::Summary& summary) noexcept
+	{
+		out.average = summary.average;
+		out.p50 = summary.p50;
+		out.p95 = summary.p95;
+		out.p99 = summary.p99;
+	}
+
+	int Application::getFrameStats(void* win, mlx_frame_stats* stats)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(win == nullptr || _graphics.get(win) == nullptr)
+		{
+			error::report(e_kind::error, "invalid window ptr");
+			return -1;
+		}
+		GraphicsSupport& gs = *_graphics.get(win);
+		const FrameStats& frame_stats = gs.getFrameStats();
+		FrameStats::Summary frame = frame_stats.summarize(FrameMetric::frame);
+		fillTimeStats(stats->frame, frame);
+		fillTimeStats(stats->hook, frame_stats.summarize(FrameMetric::hook));
+		fillTimeStats(stats->record, frame_stats.summarize(FrameMetric::record));
+		fillTimeStats(stats->submit, frame_stats.summarize(FrameMetric::submit));
+		if(gs.getRenderer().getTimestamps().isSupported())
+			fillTimeStats(stats->gpu, frame_stats.summarize(FrameMetric::gpu));
+		else
+			stats->gpu = mlx_time_stats{ -1.0, -1.0, -1.0, -1.0 };
+		stats->samples = static_cast<unsigned int>(frame.samples);
+		stats->dropped_frames = _fps.getDroppedFrames();
+		fillTimeStats(stats->pacing, _fps.getStats().summarize(FrameMetric::pacing));
+		stats->skipped_frames = gs.getFrameStats().getSkippedFrames();
+
+		const Renderer::FrameCounters& counters = gs.getRenderer().getFrameCounters();
+		stats->uploaded_bytes = counters.uploaded_bytes;
+		stats->draw_calls = counters.draw_calls;
+		stats->descriptor_binds = counters.descriptor_binds;
+		return 0;
+	}
+
+	int Application::setFrameStatsWindow(void* win, int frames)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(win == nullptr || _graphics.get(win) == nullptr)
+		{
+			error::report(e_kind::error, "invalid window ptr");
+			return -1;
+		}
+		_graphics.get(win)->getFrameStats().setWindow(static_cast<std::size_t>(frames));
+		return 0;
+	}
+
+	static constexpr VkPresentModeKHR __present_modes[] = {
+		VK_PRESENT_MODE_IMMEDIATE_KHR,
+		VK_PRESENT_MODE_MAILBOX_KHR,
+		VK_PRESENT_MODE_FIFO_KHR,
+		VK_PRESENT_MODE_FIFO_RELAXED_KHR,
+	};
+
+	int Application::setPresentMode(void* win, mlx_present_mode mode)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(win == nullptr || _graphics.get(win) == nullptr || !_graphics.get(win)->hasWindow())
+		{
+			error::report(e_kind::error, "invalid window ptr");
+			return -1;
+		}
+		Renderer& renderer = _graphics.get(win)->getRenderer();
+		renderer.getSwapChain().setPresentMode(__present_modes[mode]);
+		renderer.requireFrameBufferResize();
+		return 0;
+	}
+
+	int Application::getPresentMode(void* win)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(win == nullptr || _graphics.get(win) == nullptr || !_graphics.get(win)->hasWindow())
+		{
+			error::report(e_kind::error, "invalid window ptr");
+			return -1;
+		}
+		VkPresentModeKHR mode = _graphics.get(win)->getRenderer().getSwapChain().getPresentMode();
+		for(std::size_t i = 0; i < sizeof(__present_modes) / sizeof(__present_modes[0]); i++)
+		{
+			if(__present_modes[i] == mode)
+				return static_cast<int>(i);
+		}
+		return -1;
+	}
+
+	int Application::setSwapChainImageCount(void* win, std::uint32_t count)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(win == nullptr || _graphics.get(win) == nullptr || !_graphics.get(win)->hasWindow())
+		{
+			error::report(e_kind::error, "invalid window ptr");
+			return -1;
+		}
+		Renderer& renderer = _graphics.get(win)->getRenderer();
+		renderer.getSwapChain().setImageCountHint(count);
+		renderer.requireFrameBufferResize();
+		return 0;
 	}
 
 	Application::~Application()
 	{
+		_decoder.destroy();
 		TextLibrary::get().clearLibrary();
 		FontLibrary::get().clearLibrary();
 		if(__drop_sdl_responsability)
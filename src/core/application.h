@@ -6,18 +6,20 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 21:49:46 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/26 11:26:54 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:36:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef __MLX_APPLICATION__
 #define __MLX_APPLICATION__
 
-#include <list>
 #include <memory>
 #include <vector>
 #include <functional>
+#include <unordered_map>
+#include <string>
 
+#include <mlx.h>
 #include <core/errors.h>
 
 #include <core/graphics.h>
@@ -25,13 +27,16 @@
 #include <mlx_profile.h>
 #include <core/profiler.h>
 #include <core/fps.h>
+#include <utils/slot_map.h>
+#include <renderer/images/image_decoder.h>
+#include <core/image_cache.h>
 
 namespace mlx::core
 {
 	class Application
 	{
 		public:
-			Application();
+			Application(bool headless = false);
 
 			inline void getMousePos(int* x, int* y) noexcept;
 			inline void mouseMove(void* win, int x, int y) noexcept;
@@ -46,32 +51,75 @@ namespace mlx::core
 			inline void clearGraphicsSupport(void* win);
 			inline void destroyGraphicsSupport(void* win);
 
-			inline void pixelPut(void* win, int x, int y, std::uint32_t color) const noexcept;
+			inline void pixelPut(void* win, int x, int y, std::uint32_t color) noexcept;
 			inline void stringPut(void* win, int x, int y, std::uint32_t color, char* str);
 
 			void* newTexture(int w, int h);
 			void* newStbTexture(char* file, int* w, int* h); // stb textures are format managed by stb image (png, jpg, bpm, ...)
+			void* newStbTextureFromMemory(const std::uint8_t* data, std::size_t size, int* w, int* h);
+			void* newStbTextureAsync(char* file, void (*callback)(void*, int, int, void*), void* param); // decoded by worker threads, uploaded by the main loop
+			int getTextureLoadState(void* img);
+			inline void setImageCache(bool enabled) noexcept { _image_cache.setEnabled(enabled); }
 			inline void texturePut(void* win, void* img, int x, int y);
+			inline void texturePutBatch(void* win, void* img, const int* positions, int count);
 			inline int getTexturePixel(void* img, int x, int y);
 			inline void setTexturePixel(void* img, int x, int y, std::uint32_t color);
+			inline void setTextureRegion(void* img, int x, int y, int w, int h, const std::uint32_t* pixels);
+			inline void getTextureRegion(void* img, int x, int y, int w, int h, std::uint32_t* pixels);
 			void destroyTexture(void* ptr);
 
+			int readGraphicsSupport(void* win, void (*callback)(const int*, int, int, void*), void* param);
+			int readTextureAsync(void* img, void (*callback)(const int*, int, int, void*), void* param);
+
+			int startCapture(void* win, const char* path, CaptureFormat format, bool block);
+			int stopCapture(void* win);
+
+			double getGPUTime(void* win, int category); // category -1 is the whole frame
+			int getFrameStats(void* win, mlx_frame_stats* stats);
+			int setFrameStatsWindow(void* win, int frames);
+
+			int setPresentMode(void* win, mlx_present_mode mode);
+			int getPresentMode(void* win);
+			int setSwapChainImageCount(void* win, std::uint32_t count);
+
 			inline void loopHook(int (*f)(void*), void* param);
 			inline void loopEnd() noexcept;
 
 			inline void loadFont(void* win, const std::filesystem::path& filepath, float scale);
+			inline void loadFont(void* win, const std::uint8_t* data, std::size_t size, float scale);
 
 			void run() noexcept;
 
 			~Application();
 
 		private:
+			void uploadDecodedTextures();
+			Texture* getTexture(void* img) noexcept; // the image a handle shows, which is shared for cached loads
+			Texture* getWritableTexture(void* img); // same, copies shared images first
+
+		private:
+			struct AsyncLoad
+			{
+				std::string file;
+				void (*callback)(void*, int, int, void*);
+				void* param;
+				bool failed = false;
+			};
+
+		private:
+			ImageCache _image_cache;
+			std::unordered_map<SlotMap<Texture>::Handle, SlotMap<Texture>::Handle> _image_views; // cached loads to the image they share
+			ImageDecoder _decoder;
+			std::unordered_map<SlotMap<Texture>::Handle, AsyncLoad> _async_loads;
+			std::vector<DecodedImage> _decoded_images;
 			FpsManager _fps;
-			std::list<Texture> _textures;
-			std::vector<std::unique_ptr<GraphicsSupport>> _graphics;
+			SlotMap<Texture> _textures;
+			SlotMap<GraphicsSupport> _graphics;
 			std::function<int(void*)> _loop_hook;
 			std::unique_ptr<Input> _in;
 			void* _param = nullptr;
+			bool _headless = false;
+			bool _uploading_decoded = false; // the load callbacks may query load states
 	};
 }
 
@@ -6,11 +6,10 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 21:49:46 by maldavid          #+#    #+#             */
-/*   Updated: 2023/04/02 14:56:27 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:36:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
-#include <algorithm>
 #include <core/application.h>
 
 #define CHECK_WINDOW_PTR(win) \
@@ -19,7 +18,7 @@
 		core::error::report(e_kind::error, "invalid window ptr (NULL)"); \
 		return; \
 	} \
-	else if(*static_cast<int*>(win) < 0 || *static_cast<int*>(win) > static_cast<int>(_graphics.size()))\
+	else if(_graphics.get(win) == nullptr) \
 	{ \
 		core::error::report(e_kind::error, "invalid window ptr"); \
 		return; \
@@ -31,10 +30,7 @@
 		core::error::report(e_kind::error, "invalid image ptr (NULL)"); \
 		retval; \
 	} \
-	else if(std::find_if(_textures.begin(), _textures.end(), [=](const Texture& texture) \
-			{ \
-				return &texture == img; \
-			}) == _textures.end()) \
+	else if(_textures.get(img) == nullptr) \
 	{ \
 		core::error::report(e_kind::error, "invalid image ptr"); \
 		retval; \
@@ -51,31 +47,31 @@ namespace mlx::core
 	void Application::mouseMove(void* win, int x, int y) noexcept
 	{
 		CHECK_WINDOW_PTR(win);
-		if(!_graphics[*static_cast<int*>(win)]->hasWindow())
+		if(!_graphics.get(win)->hasWindow())
 		{
 			error::report(e_kind::warning, "trying to move the mouse relative to a window that is targeting an image and not a real window, this is not allowed (move ignored)");
 			return;
 		}
-		SDL_WarpMouseInWindow(_graphics[*static_cast<int*>(win)]->getWindow()->getNativeWindow(), x, y);
+		SDL_WarpMouseInWindow(_graphics.get(win)->getWindow()->getNativeWindow(), x, y);
 		SDL_PumpEvents();
 	}
 
 	void Application::onEvent(void* win, int event, int (*funct_ptr)(int, void*), void* param) noexcept
 	{
 		CHECK_WINDOW_PTR(win);
-		if(!_graphics[*static_cast<int*>(win)]->hasWindow())
+		if(!_graphics.get(win)->hasWindow())
 		{
 			error::report(e_kind::warning, "trying to add event hook for a window that is targeting an image and not a real window, this is not allowed (hook ignored)");
 			return;
 		}
-		_in->onEvent(_graphics[*static_cast<int*>(win)]->getWindow()->getID(), event, funct_ptr, param);
+		_in->onEvent(_graphics.get(win)->getWindow()->getID(), event, funct_ptr, param);
 	}
 
 	void Application::getScreenSize(void* win, int* w, int* h) noexcept
 	{
 		CHECK_WINDOW_PTR(win);
 		SDL_DisplayMode DM;
-		SDL_GetDesktopDisplayMode(SDL_GetWindowDisplayIndex(_graphics[*static_cast<int*>(win)]->getWindow()->getNativeWindow()), &DM);
+		SDL_GetDesktopDisplayMode(SDL_GetWindowDisplayIndex(_graphics.get(win)->getWindow()->getNativeWindow()), &DM);
 		*w = DM.w;
 		*h = DM.h;
 	}
@@ -88,12 +84,9 @@ namespace mlx::core
 	void* Application::newGraphicsSuport(std::size_t w, std::size_t h, const char* title)
 	{
 		MLX_PROFILE_FUNCTION();
-		auto it = std::find_if(_textures.begin(), _textures.end(), [=](const Texture& texture)
-		{
-			return &texture == reinterpret_cast<Texture*>(const_cast<char*>(title));
-		});
-		if(it != _textures.end())
-			_graphics.emplace_back(std::make_unique<GraphicsSupport>(w, h, reinterpret_cast<Texture*>(const_cast<char*>(title)), _graphics.size()));
+		SlotMap<GraphicsSupport>::Handle handle;
+		if(Texture* render_target = getWritableTexture(const_cast<char*>(title)); render_target != nullptr) // rendering writes into the image
+			handle = _graphics.emplace(w, h, render_target, _graphics.nextIndex());
 		else
 		{
 			if(title == NULL)
@@ -101,31 +94,36 @@ namespace mlx::core
 				core::error::report(e_kind::fatal_error, "invalid window title (NULL)");
 				return nullptr;
 			}
-			_graphics.emplace_back(std::make_unique<GraphicsSupport>(w, h, title, _graphics.size()));
-			_in->addWindow(_graphics.back()->getWindow());
+			if(_headless)
+			{
+				core::error::report(e_kind::error, "cannot create a window in headless mode, give an image to render into instead of a title");
+				return nullptr;
+			}
+			handle = _graphics.emplace(w, h, title, _graphics.nextIndex());
+			_in->addWindow(_graphics.get(handle)->getWindow());
 		}
-		return static_cast<void*>(&_graphics.back()->getID());
+		return SlotMap<GraphicsSupport>::toPointer(handle);
 	}
 
 	void Application::clearGraphicsSupport(void* win)
 	{
 		MLX_PROFILE_FUNCTION();
 		CHECK_WINDOW_PTR(win);
-		_graphics[*static_cast<int*>(win)]->clearRenderData();
+		_graphics.get(win)->clearRenderData();
 	}
 
 	void Application::destroyGraphicsSupport(void* win)
 	{
 		MLX_PROFILE_FUNCTION();
 		CHECK_WINDOW_PTR(win);
-		_graphics[*static_cast<int*>(win)].reset();
+		_graphics.erase(win);
 	}
 
-	void Application::pixelPut(void* win, int x, int y, std::uint32_t color) const noexcept
+	void Application::pixelPut(void* win, int x, int y, std::uint32_t color) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
 		CHECK_WINDOW_PTR(win);
-		_graphics[*static_cast<int*>(win)]->pixelPut(x, y, color);
+		_graphics.get(win)->pixelPut(x, y, color);
 	}
 
 	void Application::stringPut(void* win, int x, int y, std::uint32_t color, char* str)
@@ -142,14 +140,21 @@ namespace mlx::core
 			core::error::report(e_kind::warning, "trying to put an empty text");
 			return;
 		}
-		_graphics[*static_cast<int*>(win)]->stringPut(x, y, color, str);
+		_graphics.get(win)->stringPut(x, y, color, str);
 	}
 
 	void Application::loadFont(void* win, const std::filesystem::path& filepath, float scale)
 	{
 		MLX_PROFILE_FUNCTION();
 		CHECK_WINDOW_PTR(win);
-		_graphics[*static_cast<int*>(win)]->loadFont(filepath, scale);
+		_graphics.get(win)->loadFont(filepath, scale);
+	}
+
+	void Application::loadFont(void* win, const std::uint8_t* data, std::size_t size, float scale)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_WINDOW_PTR(win);
+		_graphics.get(win)->loadFont(data, size, scale);
 	}
 
 	void Application::texturePut(void* win, void* img, int x, int y)
@@ -157,18 +162,34 @@ namespace mlx::core
 		MLX_PROFILE_FUNCTION();
 		CHECK_WINDOW_PTR(win);
 		CHECK_IMAGE_PTR(img, return);
-		Texture* texture = static_cast<Texture*>(img);
-		if(!texture->isInit())
+		Texture* texture = getTexture(img);
+		if(!texture->isInit() && _async_loads.count(reinterpret_cast<SlotMap<Texture>::Handle>(img)) == 0) // textures still loading are drawn once uploaded
 			core::error::report(e_kind::error, "trying to put a texture that has been destroyed");
 		else
-			_graphics[*static_cast<int*>(win)]->texturePut(texture, x, y);
+			_graphics.get(win)->texturePut(texture, x, y);
+	}
+
+	void Application::texturePutBatch(void* win, void* img, const int* positions, int count)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_WINDOW_PTR(win);
+		CHECK_IMAGE_PTR(img, return);
+		Texture* texture = getTexture(img);
+		if(!texture->isInit() && _async_loads.count(reinterpret_cast<SlotMap<Texture>::Handle>(img)) == 0)
+		{
+			core::error::report(e_kind::error, "trying to put a texture that has been destroyed");
+			return;
+		}
+		GraphicsSupport* gs = _graphics.get(win);
+		for(int i = 0; i < count; i++)
+			gs->texturePut(texture, positions[i * 2], positions[i * 2 + 1]);
 	}
 
 	int Application::getTexturePixel(void* img, int x, int y)
 	{
 		MLX_PROFILE_FUNCTION();
 		CHECK_IMAGE_PTR(img, return 0);
-		Texture* texture = static_cast<Texture*>(img);
+		Texture* texture = getTexture(img);
 		if(!texture->isInit())
 		{
 			core::error::report(e_kind::error, "trying to get a pixel from texture that has been destroyed");
@@ -181,13 +202,35 @@ namespace mlx::core
 	{
 		MLX_PROFILE_FUNCTION();
 		CHECK_IMAGE_PTR(img, return);
-		Texture* texture = static_cast<Texture*>(img);
+		Texture* texture = getWritableTexture(img);
 		if(!texture->isInit())
 			core::error::report(e_kind::error, "trying to set a pixel on texture that has been destroyed");
 		else
 			texture->setPixel(x, y, color);
 	}
 
+	void Application::setTextureRegion(void* img, int x, int y, int w, int h, const std::uint32_t* pixels)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_IMAGE_PTR(img, return);
+		Texture* texture = getWritableTexture(img);
+		if(!texture->isInit())
+			core::error::report(e_kind::error, "trying to set a region on texture that has been destroyed");
+		else
+			texture->setRegion(x, y, w, h, pixels);
+	}
+
+	void Application::getTextureRegion(void* img, int x, int y, int w, int h, std::uint32_t* pixels)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_IMAGE_PTR(img, return);
+		Texture* texture = getTexture(img);
+		if(!texture->isInit())
+			core::error::report(e_kind::error, "trying to get a region from texture that has been destroyed");
+		else
+			texture->getRegion(x, y, w, h, pixels);
+	}
+
 	void Application::loopHook(int (*f)(void*), void* param)
 	{
 		_loop_hook = f;
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 17:35:20 by maldavid          #+#    #+#             */
-/*   Updated: 2024/02/23 22:37:24 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:37:00 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -26,22 +26,32 @@ static void* __mlx_ptr = nullptr;
 		mlx::core::error::report(e_kind::fatal_error, "invalid mlx pointer passed to '%s'", MLX_FUNC_SIG); \
 	else {} // just to avoid issues with possible if-else statements outside this macro
 
+static void* __mlx_init(bool headless)
+{
+	if(__mlx_ptr != nullptr)
+	{
+		mlx::core::error::report(e_kind::error, "MLX cannot be initialized multiple times");
+		return NULL; // not nullptr for the C compatibility
+	}
+	mlx::MemManager::get(); // just to initialize the C garbage collector
+	mlx::core::Application* app = new mlx::core::Application(headless);
+	mlx::Render_Core::get().init(headless);
+	if(app == nullptr)
+		mlx::core::error::report(e_kind::fatal_error, "Tout a pété");
+	__mlx_ptr = static_cast<void*>(app);
+	return __mlx_ptr;
+}
+
 extern "C"
 {
 	void* mlx_init()
 	{
-		if(__mlx_ptr != nullptr)
-		{
-			mlx::core::error::report(e_kind::error, "MLX cannot be initialized multiple times");
-			return NULL; // not nullptr for the C compatibility
-		}
-		mlx::MemManager::get(); // just to initialize the C garbage collector
-		mlx::core::Application* app = new mlx::core::Application;
-		mlx::Render_Core::get().init();
-		if(app == nullptr)
-			mlx::core::error::report(e_kind::fatal_error, "Tout a pété");
-		__mlx_ptr = static_cast<void*>(app);
-		return __mlx_ptr;
+		return __mlx_init(false);
+	}
+
+	void* mlx_init_headless()
+	{
+		return __mlx_init(true);
 	}
 
 	void* mlx_new_window(void* mlx, int w, int h, const char* title)
@@ -140,6 +150,137 @@ extern "C"
 		static_cast<mlx::core::Application*>(mlx)->setTexturePixel(img, x, y, *reinterpret_cast<unsigned int*>(color_bits));
 	}
 
+	void mlx_set_image_region(void* mlx, void* img, int x, int y, int w, int h, const int* pixels)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(pixels == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "invalid region pixels (NULL)");
+			return;
+		}
+		if(w <= 0 || h <= 0)
+			return;
+		static_cast<mlx::core::Application*>(mlx)->setTextureRegion(img, x, y, w, h, reinterpret_cast<const unsigned int*>(pixels));
+	}
+
+	void mlx_get_image_region(void* mlx, void* img, int x, int y, int w, int h, int* pixels)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(pixels == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "invalid region pixels (NULL)");
+			return;
+		}
+		if(w <= 0 || h <= 0)
+			return;
+		static_cast<mlx::core::Application*>(mlx)->getTextureRegion(img, x, y, w, h, reinterpret_cast<unsigned int*>(pixels));
+	}
+
+	int mlx_read_window_pixels(void* mlx, void* win, void (*callback)(const int*, int, int, void*), void* param)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(callback == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "invalid read back callback (NULL)");
+			return -1;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->readGraphicsSupport(win, callback, param);
+	}
+
+	int mlx_read_image_async(void* mlx, void* img, void (*callback)(const int*, int, int, void*), void* param)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(callback == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "invalid read back callback (NULL)");
+			return -1;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->readTextureAsync(img, callback, param);
+	}
+
+	int mlx_capture_start(void* mlx, void* win, const char* path, mlx_capture_format format, int block)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(path == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "Capture : path is NULL");
+			return -1;
+		}
+		if(format != MLX_CAPTURE_RAW && format != MLX_CAPTURE_PNG && format != MLX_CAPTURE_Y4M)
+		{
+			mlx::core::error::report(e_kind::error, "Capture : unknown format");
+			return -1;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->startCapture(win, path, static_cast<mlx::CaptureFormat>(format), block != 0);
+	}
+
+	int mlx_capture_stop(void* mlx, void* win)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		return static_cast<mlx::core::Application*>(mlx)->stopCapture(win);
+	}
+
+	double mlx_get_gpu_time(void* mlx, void* win, mlx_gpu_time category)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(category < MLX_GPU_TIME_FRAME || category > MLX_GPU_TIME_OTHER)
+		{
+			mlx::core::error::report(e_kind::error, "unknown GPU time category");
+			return -1.0;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->getGPUTime(win, static_cast<int>(category) - 1);
+	}
+
+	int mlx_get_frame_stats(void* mlx, void* win, mlx_frame_stats* stats)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(stats == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "invalid frame stats ptr (NULL)");
+			return -1;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->getFrameStats(win, stats);
+	}
+
+	int mlx_set_frame_stats_window(void* mlx, void* win, int frames)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(frames <= 0)
+		{
+			mlx::core::error::report(e_kind::error, "the frame stats window must hold at least one frame");
+			return -1;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->setFrameStatsWindow(win, frames);
+	}
+
+	int mlx_set_present_mode(void* mlx, void* win, mlx_present_mode mode)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(mode < MLX_PRESENT_IMMEDIATE || mode > MLX_PRESENT_FIFO_RELAXED)
+		{
+			mlx::core::error::report(e_kind::error, "invalid present mode");
+			return -1;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->setPresentMode(win, mode);
+	}
+
+	int mlx_get_present_mode(void* mlx, void* win)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		return static_cast<mlx::core::Application*>(mlx)->getPresentMode(win);
+	}
+
+	int mlx_set_swapchain_image_count(void* mlx, void* win, int count)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(count < 0)
+		{
+			mlx::core::error::report(e_kind::error, "invalid swapchain image count");
+			return -1;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->setSwapChainImageCount(win, static_cast<std::uint32_t>(count));
+	}
+
 	int mlx_put_image_to_window(void* mlx, void* win, void* img, int x, int y)
 	{
 		MLX_CHECK_APPLICATION_POINTER(mlx);
@@ -147,6 +288,20 @@ extern "C"
 		return 0;
 	}
 
+	int mlx_put_image_batch(void* mlx, void* win, void* img, const int* xy, int count)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(xy == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "invalid image batch positions (NULL)");
+			return 0;
+		}
+		if(count <= 0)
+			return 0;
+		static_cast<mlx::core::Application*>(mlx)->texturePutBatch(win, img, xy, count);
+		return 0;
+	}
+
 	int mlx_destroy_image(void* mlx, void* img)
 	{
 		MLX_CHECK_APPLICATION_POINTER(mlx);
@@ -168,6 +323,37 @@ extern "C"
 		return static_cast<mlx::core::Application*>(mlx)->newStbTexture(filename, width, height);
 	}
 
+	void* mlx_png_memory_to_image(void* mlx, unsigned char* data, int size, int* width, int* height)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(data == nullptr || size <= 0)
+		{
+			mlx::core::error::report(e_kind::error, "PNG loader : invalid image data");
+			return nullptr;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->newStbTextureFromMemory(data, size, width, height);
+	}
+
+	void* mlx_png_file_to_image_async(void* mlx, char* filename, void (*callback)(void* img, int width, int height, void* param), void* param)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if (filename == nullptr)
+			mlx::core::error::report(e_kind::fatal_error, "PNG loader : filename is NULL");
+		std::filesystem::path file(filename);
+		if(file.extension() != ".png")
+		{
+			mlx::core::error::report(e_kind::error, "PNG loader : not a png file '%s'", filename);
+			return nullptr;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->newStbTextureAsync(filename, callback, param);
+	}
+
+	int mlx_image_is_ready(void* mlx, void* img)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		return static_cast<mlx::core::Application*>(mlx)->getTextureLoadState(img);
+	}
+
 	void* mlx_jpg_file_to_image(void* mlx, char* filename, int* width, int* height)
 	{
 		MLX_CHECK_APPLICATION_POINTER(mlx);
@@ -196,6 +382,13 @@ extern "C"
 		return static_cast<mlx::core::Application*>(mlx)->newStbTexture(filename, width, height);
 	}
 
+	int mlx_set_image_cache(void* mlx, int enable)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->setImageCache(enable != 0);
+		return 0;
+	}
+
 	int mlx_pixel_put(void* mlx, void* win, int x, int y, int color)
 	{
 		MLX_CHECK_APPLICATION_POINTER(mlx);
@@ -257,6 +450,17 @@ extern "C"
 		static_cast<mlx::core::Application*>(mlx)->loadFont(win, file, scale);
 	}
 
+	void mlx_font_memory(void* mlx, void* win, unsigned char* data, int size, float scale)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(data == nullptr || size <= 0)
+		{
+			mlx::core::error::report(e_kind::error, "TTF loader : invalid font data");
+			return;
+		}
+		static_cast<mlx::core::Application*>(mlx)->loadFont(win, data, size, scale);
+	}
+
 	int mlx_clear_window(void* mlx, void* win)
 	{
 		MLX_CHECK_APPLICATION_POINTER(mlx);
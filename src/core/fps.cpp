@@ -6,39 +6,80 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/18 14:56:17 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:44:15 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:35:53 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <core/fps.h>
-#include <chrono>
-#include <SDL2/SDL.h>
+#include <core/profiler.h>
+#include <algorithm>
 #include <thread>
 
 namespace mlx
 {
+	namespace
+	{
+		// bounds of the spinning margin, a preempted sleep must not turn the pacer into a busy loop
+		constexpr std::chrono::microseconds MIN_SPIN_MARGIN{ 200 };
+		constexpr std::chrono::microseconds MAX_SPIN_MARGIN{ 2000 };
+		// weight of a new sleep in the running overshoot estimates
+		constexpr double OVERSHOOT_WEIGHT = 1.0 / 16.0;
+	}
+
 	void FpsManager::init()
 	{
-		_timer = SDL_GetTicks64();
-		_fps_before = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count());
-		_fps_now = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count());
+		_epoch = clock::now();
+		_frame = 0;
 	}
 
-	bool FpsManager::update()
+	void FpsManager::setMaxFPS(std::uint32_t fps) noexcept
 	{
-		using namespace std::chrono_literals;
-		_fps_now = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count());
+		_max_fps = fps;
+		_period = std::chrono::duration<double, std::nano>(1'000'000'000.0 / fps);
+		// the deadlines are rebased on the new period
+		init();
+	}
 
-		if(SDL_GetTicks64() - _timer > 1000)
-			_timer += 1000;
+	void FpsManager::update()
+	{
+		if(_max_fps == UNCAPPED)
+			return;
+		MLX_PROFILE_FUNCTION();
 
-		_fps_elapsed_time = _fps_now - _fps_before;
-		if(_fps_elapsed_time >= _ns)
+		// deadlines are computed from the epoch and not accumulated, the rounding of the period cannot drift
+		_frame++;
+		clock::time_point deadline = _epoch + std::chrono::duration_cast<clock::duration>(_period * static_cast<double>(_frame));
+		clock::time_point now = clock::now();
+		if(now - deadline >= _period)
+		{
+			// the frames whose time has passed are dropped instead of being rendered back to back
+			_dropped_frames += static_cast<std::uint64_t>((now - deadline) / _period);
+			_epoch = now;
+			_frame = 0;
+			return;
+		}
+		if(now >= deadline)
+			return; // late by less than a frame, catching up on the next deadlines
+
+		waitUntil(deadline);
+		_stats.push(FrameMetric::pacing, std::chrono::duration<double, std::milli>(clock::now() - deadline).count());
+	}
+
+	void FpsManager::waitUntil(clock::time_point deadline)
+	{
+		// the usual overshoot plus four deviations covers nearly all the sleeps
+		auto margin = std::clamp<std::chrono::duration<double, std::nano>>(_sleep_overshoot + 4.0 * _sleep_deviation, MIN_SPIN_MARGIN, std::min<std::chrono::duration<double, std::nano>>(MAX_SPIN_MARGIN, _period));
+		clock::time_point now = clock::now();
+		if(deadline - now > margin)
 		{
-			_fps_before += _ns;
-			return true;
+			auto request = std::chrono::duration_cast<clock::duration>(deadline - now - margin);
+			std::this_thread::sleep_for(request);
+			clock::time_point woken = clock::now();
+			auto overshoot = std::min<std::chrono::duration<double, std::nano>>(woken - now - request, MAX_SPIN_MARGIN);
+			_sleep_deviation += (std::chrono::abs(overshoot - _sleep_overshoot) - _sleep_deviation) * OVERSHOOT_WEIGHT;
+			_sleep_overshoot += (overshoot - _sleep_overshoot) * OVERSHOOT_WEIGHT;
 		}
-		std::this_thread::sleep_for(std::chrono::duration<double, std::nano>(_ns - 1));
-		return false;
+		while(clock::now() < deadline)
+			std::this_thread::yield();
 	}
 }
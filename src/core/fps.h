@@ -6,35 +6,55 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/18 14:53:30 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/18 15:16:06 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:35:53 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef __MLX_FPS__
 #define __MLX_FPS__
 
+#include <core/frame_stats.h>
+#include <chrono>
 #include <cstdint>
 
 namespace mlx
 {
+	/**
+	 * Paces the main loop on absolute deadlines.
+	 * The loop sleeps until shortly before the next deadline and spins for the
+	 * rest, the spinning margin follows the oversleeping the OS is measured doing.
+	 */
 	class FpsManager
 	{
+		public:
+			static constexpr std::uint32_t UNCAPPED = 1'337'000;
+
 		public:
 			FpsManager() = default;
 
 			void init();
-			bool update();
-			inline void setMaxFPS(std::uint32_t fps) noexcept { _max_fps = fps; _ns = 1000000000.0 / fps; }
+			void update();
+			void setMaxFPS(std::uint32_t fps) noexcept;
+			inline std::uint32_t getMaxFPS() const noexcept { return _max_fps; }
+			inline std::uint64_t getDroppedFrames() const noexcept { return _dropped_frames; }
+			inline const FrameStats& getStats() const noexcept { return _stats; }
 
 			~FpsManager() = default;
 
 		private:
-			double _ns = 1000000000.0 / 1'337'000.0;
-			std::uint64_t _timer = 0;
-			std::uint64_t _fps_before = 0;
-			std::uint64_t _fps_now = 0;
-			std::uint32_t _max_fps = 1'337'000;
-			std::uint32_t _fps_elapsed_time = 0;
+			using clock = std::chrono::steady_clock;
+
+			void waitUntil(clock::time_point deadline);
+
+		private:
+			FrameStats _stats; // pacing jitter only
+			clock::time_point _epoch;
+			std::chrono::duration<double, std::nano> _period{ 1'000'000'000.0 / UNCAPPED };
+			std::chrono::duration<double, std::nano> _sleep_overshoot{ 0.0 };
+			std::chrono::duration<double, std::nano> _sleep_deviation{ 0.0 };
+			std::uint64_t _frame = 0;
+			std::uint64_t _dropped_frames = 0;
+			std::uint32_t _max_fps = UNCAPPED;
 	};
 }
 
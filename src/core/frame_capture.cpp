@@ -0,0 +1,321 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frame_capture.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:21:54 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:33:48 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#include <core/frame_capture.h>
+#include <core/errors.h>
+#include <core/profiler.h>
+#include <filesystem>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+
+namespace mlx
+{
+	namespace
+	{
+		std::uint32_t crc32(std::uint32_t crc, const std::uint8_t* data, std::size_t size) noexcept
+		{
+			static const std::array<std::uint32_t, 256> table = []()
+			{
+				std::array<std::uint32_t, 256> result;
+				for(std::uint32_t i = 0; i < 256; i++)
+				{
+					std::uint32_t c = i;
+					for(int k = 0; k < 8; k++)
+						c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+					result[i] = c;
+				}
+				return result;
+			}();
+			crc = ~crc;
+			for(std::size_t i = 0; i < size; i++)
+				crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+			return ~crc;
+		}
+
+		void putBigEndian(std::vector<std::uint8_t>& out, std::uint32_t value)
+		{
+			out.push_back(static_cast<std::uint8_t>(value >> 24));
+			out.push_back(static_cast<std::uint8_t>(value >> 16));
+			out.push_back(static_cast<std::uint8_t>(value >> 8));
+			out.push_back(static_cast<std::uint8_t>(value));
+		}
+
+		void putChunk(std::ofstream& file, const char* type, const std::uint8_t* data, std::uint32_t size)
+		{
+			std::uint8_t header[8] = {
+				static_cast<std::uint8_t>(size >> 24), static_cast<std::uint8_t>(size >> 16), static_cast<std::uint8_t>(size >> 8), static_cast<std::uint8_t>(size),
+				static_cast<std::uint8_t>(type[0]), static_cast<std::uint8_t>(type[1]), static_cast<std::uint8_t>(type[2]), static_cast<std::uint8_t>(type[3])
+			};
+			std::uint32_t crc = crc32(crc32(0, header + 4, 4), data, size);
+			std::uint8_t footer[4] = { static_cast<std::uint8_t>(crc >> 24), static_cast<std::uint8_t>(crc >> 16), static_cast<std::uint8_t>(crc >> 8), static_cast<std::uint8_t>(crc) };
+			file.write(reinterpret_cast<const char*>(header), 8);
+			file.write(reinterpret_cast<const char*>(data), size);
+			file.write(reinterpret_cast<const char*>(footer), 4);
+		}
+	}
+
+	bool FrameCapture::start(std::string path, CaptureFormat format, bool block, std::uint32_t fps)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(isRunning())
+			stop();
+		if(format == CaptureFormat::png)
+		{
+			std::filesystem::path base(path);
+			if(base.extension() == ".png")
+				path = base.replace_extension().string();
+		}
+		else
+		{
+			_file.open(path, std::ios::binary | std::ios::trunc);
+			if(!_file.is_open())
+			{
+				core::error::report(e_kind::error, "Capture : cannot open '%s'", path.c_str());
+				return false;
+			}
+		}
+		_path = std::move(path);
+		_format = format;
+		_block = block;
+		_fps = (fps == 0 || fps > 1000 ? 60 : fps); // an uncapped loop has no meaningful rate
+		_frame_count = 0;
+		_dropped = 0;
+		_width = 0;
+		_height = 0;
+		_running = true;
+		_encoder = std::thread(&FrameCapture::encode, this);
+		return true;
+	}
+
+	void FrameCapture::push(const std::uint32_t* pixels, std::uint32_t width, std::uint32_t height, bool swap_red_blue)
+	{
+		MLX_PROFILE_FUNCTION();
+		Frame frame;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			if(!_running)
+				return;
+			if(_queue.size() >= QUEUE_SIZE)
+			{
+				if(!_block)
+				{
+					_dropped++;
+					return;
+				}
+				_cv.wait(lock, [this] { return _queue.size() < QUEUE_SIZE || !_running; });
+				if(!_running)
+					return;
+			}
+			if(!_pool.empty())
+			{
+				frame = std::move(_pool.back());
+				_pool.pop_back();
+			}
+		}
+		frame.pixels.assign(pixels, pixels + static_cast<std::size_t>(width) * height);
+		frame.width = width;
+		frame.height = height;
+		frame.swap_red_blue = swap_red_blue;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_queue.push_back(std::move(frame));
+		}
+		_cv.notify_all();
+	}
+
+	void FrameCapture::encode()
+	{
+		for(;;)
+		{
+			Frame frame;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_cv.wait(lock, [this] { return !_running || !_queue.empty(); });
+				if(_queue.empty()) // stopped and drained
+					return;
+				frame = std::move(_queue.front());
+				_queue.pop_front();
+			}
+			_cv.notify_all(); // a blocked push may go on
+
+			write(frame);
+
+			std::lock_guard<std::mutex> lock(_mutex);
+			_pool.push_back(std::move(frame));
+		}
+	}
+
+	void FrameCapture::write(Frame& frame)
+	{
+		if(_width == 0)
+		{
+			_width = frame.width;
+			_height = frame.height;
+			if(_format == CaptureFormat::y4m)
+				_file << "YUV4MPEG2 W" << _width << " H" << _height << " F" << _fps << ":1 Ip A1:1 C444\n";
+		}
+		else if((frame.width != _width || frame.height != _height) && _format != CaptureFormat::png)
+		{
+			// raw and y4m streams cannot change their size on the way
+			std::lock_guard<std::mutex> lock(_mutex);
+			_dropped++;
+			return;
+		}
+
+		// swizzled here rather than on the render thread
+		if(frame.swap_red_blue)
+		{
+			for(std::uint32_t& color : frame.pixels)
+				color = (color & 0xFF00FF00) | ((color & 0x00FF0000) >> 16) | ((color & 0x000000FF) << 16);
+			frame.swap_red_blue = false;
+		}
+
+		std::size_t count = static_cast<std::size_t>(frame.width) * frame.height;
+		switch(_format)
+		{
+			case CaptureFormat::raw:
+			{
+				_scratch.resize(count * 4);
+				for(std::size_t i = 0; i < count; i++)
+				{
+					std::uint32_t color = frame.pixels[i];
+					_scratch[i * 4 + 0] = static_cast<std::uint8_t>(color >> 16);
+					_scratch[i * 4 + 1] = static_cast<std::uint8_t>(color >> 8);
+					_scratch[i * 4 + 2] = static_cast<std::uint8_t>(color);
+					_scratch[i * 4 + 3] = static_cast<std::uint8_t>(color >> 24);
+				}
+				_file.write(reinterpret_cast<const char*>(_scratch.data()), _scratch.size());
+				break;
+			}
+			case CaptureFormat::y4m:
+			{
+				// BT.601 limited range, one full resolution plane per component
+				_scratch.resize(count * 3);
+				std::uint8_t* y = _scratch.data();
+				std::uint8_t* u = y + count;
+				std::uint8_t* v = u + count;
+				for(std::size_t i = 0; i < count; i++)
+				{
+					int r = (frame.pixels[i] >> 16) & 0xFF;
+					int g = (frame.pixels[i] >> 8) & 0xFF;
+					int b = frame.pixels[i] & 0xFF;
+					y[i] = static_cast<std::uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+					u[i] = static_cast<std::uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+					v[i] = static_cast<std::uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+				}
+				_file << "FRAME\n";
+				_file.write(reinterpret_cast<const char*>(_scratch.data()), _scratch.size());
+				break;
+			}
+			case CaptureFormat::png: writePNG(frame); break;
+
+			default: break;
+		}
+		_frame_count++;
+	}
+
+	void FrameCapture::writePNG(const Frame& frame)
+	{
+		char suffix[32];
+		std::snprintf(suffix, sizeof(suffix), "_%06llu.png", static_cast<unsigned long long>(_frame_count));
+		std::string path = _path + suffix;
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if(!file.is_open())
+		{
+			core::error::report(e_kind::error, "Capture : cannot open '%s'", path.c_str());
+			return;
+		}
+
+		static const std::uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		file.write(reinterpret_cast<const char*>(signature), 8);
+
+		std::vector<std::uint8_t> header;
+		putBigEndian(header, frame.width);
+		putBigEndian(header, frame.height);
+		header.insert(header.end(), { 8, 6, 0, 0, 0 }); // 8 bits RGBA, no interlacing
+		putChunk(file, "IHDR", header.data(), static_cast<std::uint32_t>(header.size()));
+
+		// the image data is stored without compression, encoding speed matters more than size here
+		std::size_t row_size = static_cast<std::size_t>(frame.width) * 4 + 1;
+		std::size_t raw_size = row_size * frame.height;
+		_scratch.clear();
+		_scratch.reserve(raw_size + raw_size / 65535 * 5 + 11);
+		_scratch.push_back(0x78);
+		_scratch.push_back(0x01);
+		std::uint32_t adler_a = 1;
+		std::uint32_t adler_b = 0;
+		std::size_t written = 0;
+		std::uint32_t x = 0;
+		std::uint32_t y = 0;
+		while(written < raw_size)
+		{
+			std::uint16_t block = static_cast<std::uint16_t>(std::min<std::size_t>(raw_size - written, 65535));
+			std::uint16_t complement = static_cast<std::uint16_t>(~block);
+			_scratch.push_back(written + block == raw_size ? 1 : 0);
+			_scratch.push_back(static_cast<std::uint8_t>(block));
+			_scratch.push_back(static_cast<std::uint8_t>(block >> 8));
+			_scratch.push_back(static_cast<std::uint8_t>(complement));
+			_scratch.push_back(static_cast<std::uint8_t>(complement >> 8));
+			for(std::uint16_t i = 0; i < block; i++)
+			{
+				std::uint8_t byte;
+				if(x == 0)
+					byte = 0; // no filter
+				else
+				{
+					std::uint32_t color = frame.pixels[static_cast<std::size_t>(y) * frame.width + (x - 1) / 4];
+					switch((x - 1) % 4)
+					{
+						case 0: byte = static_cast<std::uint8_t>(color >> 16); break;
+						case 1: byte = static_cast<std::uint8_t>(color >> 8); break;
+						case 2: byte = static_cast<std::uint8_t>(color); break;
+						default: byte = static_cast<std::uint8_t>(color >> 24); break;
+					}
+				}
+				_scratch.push_back(byte);
+				adler_a = (adler_a + byte) % 65521;
+				adler_b = (adler_b + adler_a) % 65521;
+				if(++x == row_size)
+				{
+					x = 0;
+					y++;
+				}
+			}
+			written += block;
+		}
+		putBigEndian(_scratch, (adler_b << 16) | adler_a);
+		putChunk(file, "IDAT", _scratch.data(), static_cast<std::uint32_t>(_scratch.size()));
+		putChunk(file, "IEND", nullptr, 0);
+	}
+
+	std::uint64_t FrameCapture::stop() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!isRunning())
+			return 0;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_running = false;
+		}
+		_cv.notify_all();
+		_encoder.join();
+		if(_file.is_open())
+			_file.close();
+		_pool.clear();
+		_scratch.clear();
+		_scratch.shrink_to_fit();
+		#ifdef DEBUG
+			core::error::report(e_kind::message, "Capture : wrote %llu frames, dropped %llu", static_cast<unsigned long long>(_frame_count), static_cast<unsigned long long>(_dropped));
+		#endif
+		return _dropped;
+	}
+}
@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frame_capture.h                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:21:54 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:33:48 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#ifndef __MLX_FRAME_CAPTURE__
+#define __MLX_FRAME_CAPTURE__
+
+#include <mlx_profile.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <fstream>
+#include <condition_variable>
+
+namespace mlx
+{
+	enum class CaptureFormat { raw = 0, png = 1, y4m = 2 };
+
+	/**
+	 * Writes the frames of a window to disk from an encoder thread.
+	 * Frames are handed over through a bounded queue so the render loop only
+	 * pays for a single copy of the pixels, any conversion is left to the encoder. When the queue is full new frames are either
+	 * dropped or wait for the encoder depending on the chosen policy.
+	 * raw writes every frame as RGBA8 bytes in a single file, png writes one file
+	 * per frame named <path without extension>_<frame number>.png and y4m writes
+	 * a 4:4:4 YUV4MPEG2 stream.
+	 */
+	class FrameCapture
+	{
+		public:
+			static constexpr std::size_t QUEUE_SIZE = 8;
+
+		public:
+			FrameCapture() = default;
+
+			bool start(std::string path, CaptureFormat format, bool block, std::uint32_t fps);
+			// pixels as 0xAARRGGBB, or 0xAABBGGRR if swap_red_blue is set
+			void push(const std::uint32_t* pixels, std::uint32_t width, std::uint32_t height, bool swap_red_blue = false);
+			std::uint64_t stop() noexcept; // waits for the queued frames to be written, returns the count of dropped frames
+			inline bool isRunning() const noexcept { return _encoder.joinable(); }
+
+			~FrameCapture() = default;
+
+		private:
+			struct Frame
+			{
+				std::vector<std::uint32_t> pixels;
+				std::uint32_t width = 0;
+				std::uint32_t height = 0;
+				bool swap_red_blue = false;
+			};
+
+		private:
+			void encode();
+			void write(Frame& frame);
+			void writePNG(const Frame& frame);
+
+		private:
+			std::deque<Frame> _queue;
+			std::vector<Frame> _pool; // frames already written, kept to reuse their allocations
+			std::vector<std::uint8_t> _scratch;
+			std::string _path;
+			std::ofstream _file;
+			std::thread _encoder;
+			std::mutex _mutex;
+			std::condition_variable _cv;
+			std::uint64_t _frame_count = 0;
+			std::uint64_t _dropped = 0;
+			std::uint32_t _width = 0;
+			std::uint32_t _height = 0;
+			std::uint32_t _fps = 60;
+			CaptureFormat _format = CaptureFormat::raw;
+			bool _block = false;
+			bool _running = false;
+	};
+}
+
+#endif
@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frame_stats.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:30:29 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#include <core/frame_stats.h>
+#include <core/profiler.h>
+#include <algorithm>
+#include <cmath>
+
+namespace mlx
+{
+	void FrameStats::setWindow(std::size_t frames)
+	{
+		MLX_PROFILE_FUNCTION();
+		_window = std::clamp<std::size_t>(frames, 1, MAX_WINDOW);
+		for(Ring& ring : _rings)
+		{
+			// keeps the most recent samples in order
+			std::rotate(ring.samples.begin(), ring.samples.begin() + (ring.samples.empty() ? 0 : ring.next % ring.samples.size()), ring.samples.end());
+			if(ring.samples.size() > _window)
+				ring.samples.erase(ring.samples.begin(), ring.samples.end() - _window);
+			ring.next = ring.samples.size() % _window;
+		}
+	}
+
+	void FrameStats::push(FrameMetric metric, double ms)
+	{
+		Ring& ring = _rings[static_cast<std::size_t>(metric)];
+		if(ring.samples.capacity() < _window)
+			ring.samples.reserve(_window); // once, the ring does not allocate while it fills up
+		if(ring.samples.size() < _window)
+			ring.samples.push_back(ms);
+		else
+			ring.samples[ring.next] = ms;
+		ring.next = (ring.next + 1) % _window;
+	}
+
+	FrameStats::Summary FrameStats::summarize(FrameMetric metric) const
+	{
+		MLX_PROFILE_FUNCTION();
+		const Ring& ring = _rings[static_cast<std::size_t>(metric)];
+		Summary summary;
+		summary.samples = ring.samples.size();
+		if(ring.samples.empty())
+			return summary;
+
+		_sorted = ring.samples;
+		std::sort(_sorted.begin(), _sorted.end());
+		double total = 0.0;
+		for(double sample : _sorted)
+			total += sample;
+		// nearest rank percentiles
+		auto rank = [this](double p) { return _sorted[static_cast<std::size_t>(std::ceil(p * _sorted.size())) - 1]; };
+		summary.average = total / _sorted.size();
+		summary.p50 = rank(0.50);
+		summary.p95 = rank(0.95);
+		summary.p99 = rank(0.99);
+		return summary;
+	}
+}
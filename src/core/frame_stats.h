@@ -0,0 +1,82 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frame_stats.h                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:30:29 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:35:53 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#ifndef __MLX_FRAME_STATS__
+#define __MLX_FRAME_STATS__
+
+#include <mlx_profile.h>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace mlx
+{
+	enum class FrameMetric : std::uint8_t
+	{
+		frame = 0, // CPU time between two frames
+		hook,
+		record,
+		submit, // submission and presentation
+		gpu,
+		pacing, // lateness of the main loop against its deadline
+		count
+	};
+
+	/**
+	 * Rolling timings of the last frames of a window.
+	 * Every metric keeps its last samples in a ring, percentiles are only
+	 * computed when they are asked for.
+	 */
+	class FrameStats
+	{
+		public:
+			static constexpr std::size_t DEFAULT_WINDOW = 120;
+			static constexpr std::size_t MAX_WINDOW = 8192;
+
+			struct Summary
+			{
+				double average = 0.0;
+				double p50 = 0.0;
+				double p95 = 0.0;
+				double p99 = 0.0;
+				std::size_t samples = 0;
+			};
+
+		public:
+			FrameStats() = default;
+
+			void setWindow(std::size_t frames);
+			inline std::size_t getWindow() const noexcept { return _window; }
+			void push(FrameMetric metric, double ms);
+			Summary summarize(FrameMetric metric) const;
+
+			inline void frameSkipped() noexcept { _skipped++; }
+			inline std::uint64_t getSkippedFrames() const noexcept { return _skipped; }
+
+			~FrameStats() = default;
+
+		private:
+			struct Ring
+			{
+				std::vector<double> samples;
+				std::size_t next = 0;
+			};
+
+		private:
+			std::array<Ring, static_cast<std::size_t>(FrameMetric::count)> _rings;
+			mutable std::vector<double> _sorted;
+			std::uint64_t _skipped = 0;
+			std::size_t _window = DEFAULT_WINDOW;
+	};
+}
+
+#endif
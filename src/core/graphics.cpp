@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/02 15:13:55 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/11 04:38:53 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:33:48 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -47,25 +47,69 @@ namespace mlx
 	void GraphicsSupport::render() noexcept
 	{
 		MLX_PROFILE_FUNCTION();
+		using Milliseconds = std::chrono::duration<double, std::milli>;
+		auto frame_begin = std::chrono::steady_clock::now();
 		if(!_renderer->beginFrame())
+		{
+			_stats.frameSkipped();
 			return;
+		}
+		if(_last_frame != std::chrono::steady_clock::time_point{})
+			_stats.push(FrameMetric::frame, Milliseconds(frame_begin - _last_frame).count());
+		_last_frame = frame_begin;
+		if(_renderer->getTimestamps().getCompletedFrames() != _gpu_frames)
+		{
+			_gpu_frames = _renderer->getTimestamps().getCompletedFrames();
+			_stats.push(FrameMetric::gpu, _renderer->getTimestamps().getFrameTime());
+		}
+		auto record_begin = std::chrono::steady_clock::now();
+
+		_texture_manager.update(*_renderer);
+		_pixel_put_pipeline.update(*_renderer);
+
+		_renderer->beginRenderPass();
+
 		_proj = glm::ortho<float>(0, _width, 0, _height);
 		_renderer->getUniformBuffer()->setData(sizeof(_proj), &_proj);
 
-		static std::array<VkDescriptorSet, 2> sets = {
-			_renderer->getVertDescriptorSet().get(), 
+		std::array<VkDescriptorSet, 2> sets = {
+			_renderer->getVertDescriptorSet().get(),
 			VK_NULL_HANDLE
 		};
 
-		for(auto& data : _drawlist)
-			data->render(sets, *_renderer);
+		for(std::size_t i = 0; i < _drawlist.size(); i++)
+		{
+			switch(_drawlist.getKind(i))
+			{
+				case DrawCommandKind::texture:
+				{
+					Texture* texture = _texture_manager.getTexture(_drawlist.getResource(i));
+					if(texture->isInit())
+						_renderer->getSpriteBatch().push(texture, _drawlist.getX(i), _drawlist.getY(i));
+					break;
+				}
+				case DrawCommandKind::text: _text_manager.getText(_drawlist.getResource(i)).render(sets, *_renderer); break;
+
+				default: break;
+			}
+		}
 
 		_pixel_put_pipeline.render(sets, *_renderer);
 
-		_renderer->endFrame();
+		if(_capture.isRunning())
+		{
+			// the frame is copied at the end of its command buffer and reaches the encoder a frame or two later,
+			// straight from the readback buffer as the capture makes its own copy anyway
+			_renderer->getReadbacks().requestMapped(nullptr, [this](const std::uint32_t* pixels, std::uint32_t w, std::uint32_t h, bool swap_red_blue)
+			{
+				_capture.push(pixels, w, h, swap_red_blue);
+			});
+		}
 
-		for(auto& data : _drawlist)
-			data->resetUpdate();
+		auto submit_begin = std::chrono::steady_clock::now();
+		_stats.push(FrameMetric::record, Milliseconds(submit_begin - record_begin).count());
+		_renderer->endFrame();
+		_stats.push(FrameMetric::submit, Milliseconds(std::chrono::steady_clock::now() - submit_begin).count());
 
 		#ifdef GRAPHICS_MEMORY_DUMP
 			// dump memory to file every two seconds
@@ -84,7 +128,8 @@ namespace mlx
 		vkDeviceWaitIdle(Render_Core::get().getDevice().get());
 		_text_manager.destroy();
 		_pixel_put_pipeline.destroy();
-		_renderer->destroy();
+		_renderer->destroy(); // delivers the last captured frames
+		_capture.stop();
 		if(_window)
 			_window->destroy();
 	}
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/02 14:49:49 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/24 14:43:09 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -22,11 +22,14 @@
 #include <platform/window.h>
 #include <renderer/renderer.h>
 #include <renderer/pixel_put.h>
-#include <renderer/core/drawable_resource.h>
+#include <renderer/draw_list.h>
 #include <renderer/images/texture_manager.h>
 #include <renderer/texts/text_manager.h>
 #include <utils/non_copyable.h>
 #include <renderer/images/texture.h>
+#include <core/frame_capture.h>
+#include <core/frame_stats.h>
+#include <chrono>
 #include <mlx_profile.h>
 #include <core/profiler.h>
 
@@ -38,31 +41,41 @@ namespace mlx
 			GraphicsSupport(std::size_t w, std::size_t h, Texture* render_target, int id);
 			GraphicsSupport(std::size_t w, std::size_t h, std::string title, int id);
 
-			inline int& getID() noexcept;
+			inline int getID() const noexcept;
 			inline std::shared_ptr<MLX_Window> getWindow();
 
 			void render() noexcept;
 
 			inline void clearRenderData() noexcept;
 			inline void pixelPut(int x, int y, std::uint32_t color) noexcept;
-			inline void stringPut(int x, int y, std::uint32_t color, std::string str);
+			inline void stringPut(int x, int y, std::uint32_t color, std::string_view str);
 			inline void texturePut(Texture* texture, int x, int y);
 			inline void loadFont(const std::filesystem::path& filepath, float scale);
+			inline void loadFont(const std::uint8_t* data, std::size_t size, float scale);
 			inline void tryEraseTextureFromManager(Texture* texture) noexcept;
 
+			inline bool startCapture(std::string path, CaptureFormat format, bool block, std::uint32_t fps);
+			inline std::uint64_t stopCapture() noexcept { return _capture.stop(); }
+
 			inline bool hasWindow() const noexcept  { return _has_window; }
 
 			inline Renderer& getRenderer() { return *_renderer; }
+			inline FrameStats& getFrameStats() noexcept { return _stats; }
 
 			~GraphicsSupport();
 
 		private:
 			PixelPutPipeline _pixel_put_pipeline;
 
-			std::vector<DrawableResource*> _drawlist;
+			DrawList _drawlist;
 			
 			TextManager _text_manager;
 			TextureManager _texture_manager;
+
+			FrameCapture _capture;
+			FrameStats _stats;
+			std::chrono::steady_clock::time_point _last_frame;
+			std::uint64_t _gpu_frames = 0;
 			
 			glm::mat4 _proj = glm::mat4(1.0);
 			
@@ -6,16 +6,15 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/02 15:13:55 by maldavid          #+#    #+#             */
-/*   Updated: 2023/04/02 15:26:16 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
-#include <algorithm>
 #include <core/graphics.h>
 
 namespace mlx
 {
-	int& GraphicsSupport::getID() noexcept { return _id; }
+	int GraphicsSupport::getID() const noexcept { return _id; }
 	std::shared_ptr<MLX_Window> GraphicsSupport::getWindow() { return _window; }
 
 	void GraphicsSupport::clearRenderData() noexcept
@@ -33,30 +32,18 @@ namespace mlx
 		_pixel_put_pipeline.setPixel(x, y, color);
 	}
 
-	void GraphicsSupport::stringPut(int x, int y, std::uint32_t color, std::string str)
+	void GraphicsSupport::stringPut(int x, int y, std::uint32_t color, std::string_view str)
 	{
 		MLX_PROFILE_FUNCTION();
-		std::pair<DrawableResource*, bool> res = _text_manager.registerText(x, y, color, str);
-		if(!res.second) // if this is not a completly new text draw
-		{
-			auto it = std::find(_drawlist.begin(), _drawlist.end(), res.first);
-			if(it != _drawlist.end())
-				_drawlist.erase(it);
-		}
-		_drawlist.push_back(res.first);
+		std::uint32_t text = _text_manager.registerText(x, y, color, str);
+		_drawlist.push(DrawCommandKind::text, text, x, y);
 	}
 
 	void GraphicsSupport::texturePut(Texture* texture, int x, int y)
 	{
 		MLX_PROFILE_FUNCTION();
-		auto res = _texture_manager.registerTexture(texture, x, y);
-		if(!res.second) // if this is not a completly new texture draw
-		{
-			auto it = std::find(_drawlist.begin(), _drawlist.end(), res.first);
-			if(it != _drawlist.end())
-				_drawlist.erase(it);
-		}
-		_drawlist.push_back(res.first);
+		std::uint32_t index = _texture_manager.registerTexture(texture);
+		_drawlist.push(DrawCommandKind::texture, index, x, y);
 	}
 
 	void GraphicsSupport::loadFont(const std::filesystem::path& filepath, float scale)
@@ -65,16 +52,30 @@ namespace mlx
 		_text_manager.loadFont(*_renderer, filepath, scale);
 	}
 
+	void GraphicsSupport::loadFont(const std::uint8_t* data, std::size_t size, float scale)
+	{
+		MLX_PROFILE_FUNCTION();
+		_text_manager.loadFont(*_renderer, data, size, scale);
+	}
+
 	void GraphicsSupport::tryEraseTextureFromManager(Texture* texture) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		for(auto it = _drawlist.begin(); it != _drawlist.end();)
+		std::uint32_t index;
+		if(!_texture_manager.getIndex(texture, index))
+			return;
+		_drawlist.eraseResource(DrawCommandKind::texture, index);
+		_texture_manager.eraseTexture(texture);
+	}
+
+	bool GraphicsSupport::startCapture(std::string path, CaptureFormat format, bool block, std::uint32_t fps)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_has_window && !_renderer->getSwapChain().isReadable())
 		{
-			if(_texture_manager.isTextureKnown(texture))
-				it = _drawlist.erase(it);
-			else
-				++it;
+			core::error::report(e_kind::error, "Capture : the window surface does not support being read back");
+			return false;
 		}
-		_texture_manager.eraseTextures(texture);
+		return _capture.start(std::move(path), format, block, fps);
 	}
 }
@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   image_cache.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:12:56 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:36:35 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <core/image_cache.h>
+#include <core/profiler.h>
+
+namespace mlx
+{
+	bool ImageCache::makeKey(const std::filesystem::path& file, ImageCacheKey& key)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::error_code err;
+		std::filesystem::path path = std::filesystem::canonical(file, err);
+		if(err)
+			return false;
+		auto mtime = std::filesystem::last_write_time(path, err);
+		if(err)
+			return false;
+		std::uintmax_t size = std::filesystem::file_size(path, err);
+		if(err)
+			return false;
+		key.path = path.string();
+		key.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+		key.size = size;
+		return true;
+	}
+
+	bool ImageCache::acquire(const ImageCacheKey& key, Handle& handle)
+	{
+		MLX_PROFILE_FUNCTION();
+		auto it = _handles.find(key);
+		if(it == _handles.end())
+		{
+			MLX_PROFILE_COUNTER("image cache misses", 1);
+			return false;
+		}
+		MLX_PROFILE_COUNTER("image cache hits", 1);
+		handle = it->second;
+		_entries[handle].references++;
+		return true;
+	}
+
+	void ImageCache::insert(ImageCacheKey key, Handle handle)
+	{
+		MLX_PROFILE_FUNCTION();
+		_handles[key] = handle;
+		_entries[handle] = Entry{ std::move(key), 1 };
+	}
+
+	bool ImageCache::release(Handle handle)
+	{
+		MLX_PROFILE_FUNCTION();
+		auto it = _entries.find(handle);
+		if(it == _entries.end())
+			return false;
+		if(--it->second.references != 0)
+			return true;
+		_handles.erase(it->second.key);
+		_entries.erase(it);
+		return false;
+	}
+
+	bool ImageCache::isShared(Handle handle) const noexcept
+	{
+		auto it = _entries.find(handle);
+		return it != _entries.end() && it->second.references > 1;
+	}
+
+	void ImageCache::forget(Handle handle)
+	{
+		MLX_PROFILE_FUNCTION();
+		auto it = _entries.find(handle);
+		if(it == _entries.end())
+			return;
+		_handles.erase(it->second.key);
+		_entries.erase(it);
+	}
+}
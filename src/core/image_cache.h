@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   image_cache.h                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:12:56 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:36:35 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_IMAGE_CACHE__
+#define __MLX_IMAGE_CACHE__
+
+#include <mlx_profile.h>
+#include <cstdint>
+#include <string>
+#include <filesystem>
+#include <unordered_map>
+#include <utils/combine_hash.h>
+
+namespace mlx
+{
+	struct ImageCacheKey
+	{
+		std::string path; // canonical
+		std::int64_t mtime;
+		std::uintmax_t size;
+
+		inline bool operator==(const ImageCacheKey& rhs) const noexcept { return size == rhs.size && mtime == rhs.mtime && path == rhs.path; }
+	};
+}
+
+namespace std
+{
+	template <>
+	struct hash<mlx::ImageCacheKey>
+	{
+		std::size_t operator()(const mlx::ImageCacheKey& k) const noexcept
+		{
+			std::size_t hash = 0;
+			mlx::hashCombine(hash, k.path, k.mtime, k.size);
+			return hash;
+		}
+	};
+}
+
+namespace mlx
+{
+	/**
+	 * Opt-in cache of the images loaded from files.
+	 * Loading a file that did not change since it was last loaded gives back the
+	 * same image with one more reference instead of decoding and uploading it again.
+	 * Images are identified by their handle, an image is only destroyed once all
+	 * the loads that returned it have been released.
+	 * Cached images are never written: a load that wants to write its image gets
+	 * a private copy if the image is shared, or takes it out of the cache if not.
+	 */
+	class ImageCache
+	{
+		public:
+			using Handle = std::uintptr_t;
+
+		public:
+			ImageCache() = default;
+
+			static bool makeKey(const std::filesystem::path& file, ImageCacheKey& key);
+
+			inline void setEnabled(bool enabled) noexcept { _enabled = enabled; }
+			inline bool isEnabled() const noexcept { return _enabled; }
+
+			bool acquire(const ImageCacheKey& key, Handle& handle); // true and one more reference on a hit
+			void insert(ImageCacheKey key, Handle handle);
+			bool release(Handle handle); // true if the image is still referenced by other loads
+			bool isShared(Handle handle) const noexcept;
+			void forget(Handle handle); // the image is not given to new loads anymore, it stays owned by its only reference
+
+			~ImageCache() = default;
+
+		private:
+			struct Entry
+			{
+				ImageCacheKey key;
+				std::size_t references;
+			};
+
+		private:
+			std::unordered_map<ImageCacheKey, Handle> _handles;
+			std::unordered_map<Handle, Entry> _entries;
+			bool _enabled = false;
+	};
+}
+
+#endif
@@ -6,60 +6,111 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/12/07 16:32:01 by kbz_8             #+#    #+#             */
-/*   Updated: 2023/12/11 15:25:02 by kbz_8            ###   ########.fr       */
+/*   Updated: 2026/10/16 23:37:39 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <core/memory.h>
 #include <core/errors.h>
-#include <algorithm>
+#include <cstdlib>
+#include <limits>
 
 namespace mlx
 {
+	namespace
+	{
+		constexpr std::uint64_t BLOCK_MAGIC = 0x4D4C584D454D424Bull; // "MLXMEMBK"
+	}
+
+	void* MemManager::link(Header* header) noexcept
+	{
+		header->magic = BLOCK_MAGIC;
+		header->prev = nullptr;
+		std::unique_lock<std::mutex> lock(_mutex);
+		header->next = _blocks;
+		if(_blocks != nullptr)
+			_blocks->prev = header;
+		_blocks = header;
+		return header + 1;
+	}
+
+	MemManager::Header* MemManager::unlink(void* ptr) noexcept
+	{
+		Header* header = static_cast<Header*>(ptr) - 1;
+		std::unique_lock<std::mutex> lock(_mutex);
+		if(_collected) // the block has already been freed by the collection at exit
+			return nullptr;
+		if(header->magic != BLOCK_MAGIC)
+		{
+			core::error::report(e_kind::error, "Memory Manager : trying to free a pointer not allocated by the memory manager");
+			return nullptr;
+		}
+		header->magic = 0;
+		if(header->prev != nullptr)
+			header->prev->next = header->next;
+		else
+			_blocks = header->next;
+		if(header->next != nullptr)
+			header->next->prev = header->prev;
+		return header;
+	}
+
 	void* MemManager::malloc(std::size_t size)
 	{
-		void* ptr = std::malloc(size);
-		if(ptr != nullptr)
-			_blocks.push_back(ptr);
-		return ptr;
+		if(size > std::numeric_limits<std::size_t>::max() - sizeof(Header))
+			return nullptr;
+		Header* header = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+		if(header == nullptr)
+			return nullptr;
+		return link(header);
 	}
 
 	void* MemManager::calloc(std::size_t n, std::size_t size)
 	{
-		void* ptr = std::calloc(n, size);
-		if(ptr != nullptr)
-			_blocks.push_back(ptr);
-		return ptr;
+		if(size != 0 && n > (std::numeric_limits<std::size_t>::max() - sizeof(Header)) / size)
+			return nullptr;
+		Header* header = static_cast<Header*>(std::calloc(1, sizeof(Header) + n * size));
+		if(header == nullptr)
+			return nullptr;
+		return link(header);
 	}
 
 	void* MemManager::realloc(void* ptr, std::size_t size)
 	{
-		void* ptr2 = std::realloc(ptr, size);
-		if(ptr2 != nullptr)
-			_blocks.push_back(ptr2);
-		auto it = std::find(_blocks.begin(), _blocks.end(), ptr);
-		if(it != _blocks.end())
-			_blocks.erase(it);
-		return ptr2;
+		if(ptr == nullptr)
+			return malloc(size);
+		if(size > std::numeric_limits<std::size_t>::max() - sizeof(Header))
+			return nullptr;
+		Header* header = unlink(ptr);
+		if(header == nullptr)
+			return nullptr;
+		Header* new_header = static_cast<Header*>(std::realloc(header, sizeof(Header) + size));
+		if(new_header == nullptr)
+		{
+			link(header); // the original block is still valid and stays tracked
+			return nullptr;
+		}
+		return link(new_header);
 	}
 
 	void MemManager::free(void* ptr)
 	{
-		auto it = std::find(_blocks.begin(), _blocks.end(), ptr);
-		if(it == _blocks.end())
-		{
-			core::error::report(e_kind::error, "Memory Manager : trying to free a pointer not allocated by the memory manager");
+		if(ptr == nullptr)
 			return;
-		}
-		std::free(*it);
-		_blocks.erase(it);
+		Header* header = unlink(ptr);
+		if(header != nullptr)
+			std::free(header);
 	}
 
 	MemManager::~MemManager()
 	{
-		std::for_each(_blocks.begin(), _blocks.end(), [](void* ptr)
+		std::unique_lock<std::mutex> lock(_mutex);
+		while(_blocks != nullptr)
 		{
-			std::free(ptr);
-		});
+			Header* next = _blocks->next;
+			std::free(_blocks);
+			_blocks = next;
+		}
+		_collected = true;
 	}
 }
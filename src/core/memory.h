@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/12/07 16:31:51 by kbz_8             #+#    #+#             */
-/*   Updated: 2023/12/11 19:47:13 by kbz_8            ###   ########.fr       */
+/*   Updated: 2026/10/16 23:37:39 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,10 +15,18 @@
 
 #include <utils/singleton.h>
 #include <mlx_profile.h>
-#include <list>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 
 namespace mlx
 {
+	/**
+	 * C allocator given to SDL and stb, everything still allocated when the
+	 * application ends is freed.
+	 * Every block is prefixed by a header linking it in an intrusive list so
+	 * tracking costs the same whatever the number of live blocks.
+	 */
 	class MemManager : public Singleton<MemManager>
 	{
 		friend class Singleton<MemManager>;
@@ -29,12 +37,25 @@ namespace mlx
 			static void* realloc(void* ptr, std::size_t size);
 			static void free(void* ptr);
 
+		private:
+			struct alignas(std::max_align_t) Header
+			{
+				Header* prev;
+				Header* next;
+				std::uint64_t magic;
+			};
+
 		private:
 			MemManager() = default;
 			~MemManager();
 
+			static void* link(Header* header) noexcept;
+			static Header* unlink(void* ptr) noexcept;
+
 		private:
-			inline static std::list<void*> _blocks;
+			inline static std::mutex _mutex;
+			inline static Header* _blocks = nullptr;
+			inline static bool _collected = false;
 	};
 }
 
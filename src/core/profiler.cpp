@@ -6,74 +6,202 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/10 13:56:21 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/10 18:17:35 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:29:57 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <core/profiler.h>
 #include <core/errors.h>
-#include <iostream>
+#include <algorithm>
+#include <cstdio>
 
 namespace mlx
 {
+	static void writeEscaped(std::ofstream& stream, std::string_view str)
+	{
+		for(char c : str)
+		{
+			if(c == '"' || c == '\\')
+				stream << '\\';
+			stream << c;
+		}
+	}
+
+	// microseconds with a nanosecond precision, the unit of trace events timestamps
+	static void writeMicroseconds(std::ofstream& stream, std::uint64_t ns)
+	{
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%llu.%03llu", static_cast<unsigned long long>(ns / 1000), static_cast<unsigned long long>(ns % 1000));
+		stream << buffer;
+	}
+
 	void Profiler::beginRuntimeSession()
 	{
 		std::lock_guard lock(_mutex);
 		if(_runtime_session_began)
 			return;
+		if(_gpu_buffer == nullptr)
+		{
+			_gpu_buffer = _buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+			_gpu_buffer->id = 0;
+		}
 		_output_stream.open("./runtime_profile.mlx.json", std::ofstream::out | std::ofstream::trunc);
 
-		if(_output_stream.is_open())
-			writeHeader();
-		else
+		if(!_output_stream.is_open())
+		{
 			core::error::report(e_kind::error, "Profiler : cannot open runtime profile file");
+			return;
+		}
+		_output_stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+		_output_stream << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+		_first_event = false;
 		_runtime_session_began = true;
+		_flusher = std::thread(&Profiler::flushLoop, this);
+	}
+
+	Profiler::ThreadBuffer* Profiler::registerThread()
+	{
+		std::lock_guard lock(_mutex);
+		ThreadBuffer* buffer = _buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+		buffer->id = _next_thread_id++;
+		return buffer;
+	}
+
+	void Profiler::push(ThreadBuffer& buffer, const ProfileEvent& event) noexcept
+	{
+		std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+		std::uint64_t used = head - buffer.tail.load(std::memory_order_acquire);
+		if(used >= ThreadBuffer::CAPACITY)
+		{
+			buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		buffer.events[head % ThreadBuffer::CAPACITY] = event;
+		buffer.head.store(head + 1, std::memory_order_release);
+		if(used == ThreadBuffer::CAPACITY / 2) // wakes the flusher early on bursts
+			_cv.notify_one();
+	}
+
+	void Profiler::appendEvent(const char* name, std::uint64_t begin, std::uint64_t end) noexcept
+	{
+		thread_local ThreadBuffer* buffer = registerThread();
+		push(*buffer, ProfileEvent{ name, begin, end });
+	}
+
+	void Profiler::appendGPUEvent(const char* name, std::uint64_t begin, std::uint64_t end) noexcept
+	{
+		if(_gpu_buffer != nullptr)
+			push(*_gpu_buffer, ProfileEvent{ name, begin, end });
 	}
 
-	void Profiler::appendProfileData(ProfileResult&& result)
+	void Profiler::appendCounter(const char* name, std::int64_t value)
 	{
 		std::lock_guard lock(_mutex);
-		auto it = _profile_data.find(result.name);
-		if(it != _profile_data.end())
+		_counters[name] += value;
+	}
+
+	void Profiler::flushLoop()
+	{
+		std::unique_lock lock(_flush_mutex);
+		while(_runtime_session_began)
 		{
-			result.elapsed_time = (result.elapsed_time + it->second.second.elapsed_time) / it->second.first;
-			_profile_data[result.name].first++;
-			_profile_data[result.name].second = result;
+			_cv.wait_for(lock, std::chrono::milliseconds(100));
+			drain();
 		}
-		else
-			_profile_data[result.name] = std::make_pair(1, result);
 	}
 
-	void Profiler::writeProfile(const ProfileResult& result)
+	void Profiler::drain()
 	{
-		std::stringstream json;
-		json << std::setprecision(9) << std::fixed;
-		json << ",\n{\n";
-		json << "\t\"type\" : \"function\"," << '\n';
-		json << "\t\"name\" : \"" << result.name << "\"," << '\n';
-		json << "\t\"thread id\" : " << result.thread_id << "," << '\n';
-		json << "\t\"average duration\" : \"" << result.elapsed_time.count() << "ms\"\n";
-		json << "}";
-		_output_stream << json.str();
+		std::vector<ThreadBuffer*> buffers;
+		{
+			std::lock_guard lock(_mutex);
+			for(auto& buffer : _buffers)
+				buffers.push_back(buffer.get());
+		}
+		for(ThreadBuffer* buffer : buffers)
+		{
+			std::uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+			std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+			for(; tail < head; tail++)
+			{
+				const ProfileEvent& event = buffer->events[tail % ThreadBuffer::CAPACITY];
+				std::uint64_t duration = event.end - event.begin;
+
+				Statistics& stats = _statistics[event.name];
+				stats.calls++;
+				stats.total += duration;
+				stats.min = std::min(stats.min, duration);
+				stats.max = std::max(stats.max, duration);
+
+				_output_stream << (_first_event ? "\n" : ",\n") << "{\"name\":\"";
+				writeEscaped(_output_stream, event.name);
+				_output_stream << "\",\"cat\":\"" << (buffer == _gpu_buffer ? "gpu" : "function") << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->id << ",\"ts\":";
+				writeMicroseconds(_output_stream, event.begin);
+				_output_stream << ",\"dur\":";
+				writeMicroseconds(_output_stream, duration);
+				_output_stream << '}';
+				_first_event = false;
+			}
+			buffer->tail.store(tail, std::memory_order_release);
+		}
+		_output_stream.flush();
 	}
 
 	void Profiler::endRuntimeSession()
 	{
+		{
+			std::lock_guard lock(_flush_mutex);
+			if(!_runtime_session_began)
+				return;
+			_runtime_session_began = false;
+		}
+		_cv.notify_all();
+		_flusher.join();
+		drain();
+
 		std::lock_guard lock(_mutex);
-		if(!_runtime_session_began)
-			return;
-		for(auto& [_, pair] : _profile_data)
-			writeProfile(pair.second);
-		writeFooter();
+		std::uint64_t end = now();
+		for(auto& [name, value] : _counters)
+		{
+			_output_stream << (_first_event ? "\n" : ",\n") << "{\"name\":\"";
+			writeEscaped(_output_stream, name);
+			_output_stream << "\",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":";
+			writeMicroseconds(_output_stream, end);
+			_output_stream << ",\"args\":{\"value\":" << value << "}}";
+			_first_event = false;
+		}
+		_output_stream << "\n],\n\"mlxStatistics\":[";
+
+		// aggregates are only computed here, far from the measured code
+		bool first = true;
+		for(auto& [name, stats] : _statistics)
+		{
+			_output_stream << (first ? "\n" : ",\n") << "{\"name\":\"";
+			writeEscaped(_output_stream, name);
+			_output_stream << "\",\"calls\":" << stats.calls << ",\"total_us\":";
+			writeMicroseconds(_output_stream, stats.total);
+			_output_stream << ",\"average_us\":";
+			writeMicroseconds(_output_stream, stats.total / stats.calls);
+			_output_stream << ",\"min_us\":";
+			writeMicroseconds(_output_stream, stats.min);
+			_output_stream << ",\"max_us\":";
+			writeMicroseconds(_output_stream, stats.max);
+			_output_stream << '}';
+			first = false;
+		}
+		std::uint64_t dropped = 0;
+		for(auto& buffer : _buffers)
+			dropped += buffer->dropped.load(std::memory_order_relaxed);
+		_output_stream << "\n],\n\"mlxDroppedEvents\":" << dropped << "\n}\n";
 		_output_stream.close();
-		_profile_data.clear();
-		_runtime_session_began = false;
+		_statistics.clear();
+		_counters.clear();
+		if(dropped != 0)
+			core::error::report(e_kind::warning, "Profiler : %llu events were dropped, the profile is incomplete", static_cast<unsigned long long>(dropped));
 	}
 
 	Profiler::~Profiler()
 	{
-		if(!_runtime_session_began)
-			return;
 		endRuntimeSession();
 	}
 }
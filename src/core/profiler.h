@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/10 13:35:45 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/24 14:41:27 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:29:57 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,24 +17,34 @@
 #include <mlx_profile.h>
 #include <chrono>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <array>
+#include <memory>
+#include <vector>
 #include <fstream>
 #include <unordered_map>
-#include <sstream>
-#include <iomanip>
+#include <condition_variable>
+#include <cstdint>
 
 namespace mlx
 {
-	using FloatingPointMilliseconds = std::chrono::duration<double, std::milli>;
-
-	struct ProfileResult
+	struct ProfileEvent
 	{
-		std::string name;
-		FloatingPointMilliseconds elapsed_time;
-		std::thread::id thread_id;
+		const char* name; // must point to static storage, it is read by the flushing thread
+		std::uint64_t begin; // nanoseconds since the start of the session
+		std::uint64_t end;
 	};
 
+	/**
+	 * Records timed scopes into Chrome trace event JSON (viewable in Perfetto or chrome://tracing).
+	 * Each thread writes its events into its own single producer ring without
+	 * locking nor allocating, a background thread drains the rings to the file
+	 * and computes the per scope statistics written at the end of the session.
+	 * Events recorded while a ring is full are dropped and counted.
+	 */
 	class Profiler : public Singleton<Profiler>
 	{
 		friend class Singleton<Profiler>;
@@ -43,50 +53,66 @@ namespace mlx
 			Profiler(const Profiler&) = delete;
 			Profiler(Profiler&&) = delete;
 
-			void appendProfileData(ProfileResult&& result);
+			inline std::uint64_t now() const noexcept { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _origin).count(); }
+			void appendEvent(const char* name, std::uint64_t begin, std::uint64_t end) noexcept;
+			void appendGPUEvent(const char* name, std::uint64_t begin, std::uint64_t end) noexcept; // main thread only
+			void appendCounter(const char* name, std::int64_t value);
+
+		private:
+			struct ThreadBuffer
+			{
+				static constexpr std::size_t CAPACITY = 1 << 16;
+
+				std::array<ProfileEvent, CAPACITY> events;
+				std::atomic<std::uint64_t> head{0}; // written by the owning thread
+				std::atomic<std::uint64_t> tail{0}; // written by the flushing thread
+				std::atomic<std::uint64_t> dropped{0};
+				std::uint32_t id;
+			};
+
+			struct Statistics
+			{
+				std::uint64_t calls = 0;
+				std::uint64_t total = 0;
+				std::uint64_t min = UINT64_MAX;
+				std::uint64_t max = 0;
+			};
 
 		private:
 			Profiler() { beginRuntimeSession(); }
 			~Profiler();
 
+			ThreadBuffer* registerThread();
+			void push(ThreadBuffer& buffer, const ProfileEvent& event) noexcept;
 			void beginRuntimeSession();
-			void writeProfile(const ProfileResult& result);
+			void flushLoop();
+			void drain();
 			void endRuntimeSession();
-			inline void writeHeader()
-			{
-				_output_stream << "{\"profileData\":[{}";
-				_output_stream.flush();
-			}
-
-			inline void writeFooter()
-			{
-				_output_stream << "]}";
-				_output_stream.flush();
-			}
 
 		private:
-			std::unordered_map<std::string, std::pair<std::size_t, ProfileResult>> _profile_data;
+			std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+			ThreadBuffer* _gpu_buffer = nullptr; // GPU times get their own track
+			std::unordered_map<std::string_view, Statistics> _statistics; // only touched by the flushing side
+			std::unordered_map<std::string, std::int64_t> _counters;
+			std::chrono::steady_clock::time_point _origin = std::chrono::steady_clock::now();
 			std::ofstream _output_stream;
+			std::thread _flusher;
 			std::mutex _mutex;
+			std::mutex _flush_mutex;
+			std::condition_variable _cv;
+			std::uint32_t _next_thread_id = 1;
+			bool _first_event = true;
 			bool _runtime_session_began = false;
 	};
 
 	class ProfilerTimer
 	{
 		public:
-			ProfilerTimer(const char* name) : _name(name)
-			{
-				_start_timepoint = std::chrono::steady_clock::now();
-			}
+			ProfilerTimer(const char* name) : _name(name), _begin(Profiler::get().now()) {}
 
-			inline void stop()
+			inline void stop() noexcept
 			{
-				auto end_timepoint = std::chrono::steady_clock::now();
-				auto high_res_start = FloatingPointMilliseconds{ _start_timepoint.time_since_epoch() };
-				auto elapsed_time = std::chrono::time_point_cast<std::chrono::milliseconds>(end_timepoint).time_since_epoch() - std::chrono::time_point_cast<std::chrono::milliseconds>(_start_timepoint).time_since_epoch();
-
-				Profiler::get().appendProfileData({ _name, elapsed_time, std::this_thread::get_id() });
-
+				Profiler::get().appendEvent(_name, _begin, Profiler::get().now());
 				_stopped = true;
 			}
 
@@ -97,8 +123,8 @@ namespace mlx
 			}
 
 		private:
-			std::chrono::time_point<std::chrono::steady_clock> _start_timepoint;
 			const char* _name;
+			std::uint64_t _begin;
 			bool _stopped = false;
 	};
 
@@ -133,14 +159,16 @@ namespace mlx
 }
 
 #ifdef PROFILER
-	#define MLX_PROFILE_SCOPE_LINE2(name, line) constexpr auto fixedName##line = ::mlx::ProfilerUtils::cleanupOutputString(name, "__cdecl ");\
+	#define MLX_PROFILE_SCOPE_LINE2(name, line) static constexpr auto fixedName##line = ::mlx::ProfilerUtils::cleanupOutputString(name, "__cdecl ");\
 												::mlx::ProfilerTimer timer##line(fixedName##line.data)
 	#define MLX_PROFILE_SCOPE_LINE(name, line) MLX_PROFILE_SCOPE_LINE2(name, line)
 	#define MLX_PROFILE_SCOPE(name) MLX_PROFILE_SCOPE_LINE(name, __LINE__)
 	#define MLX_PROFILE_FUNCTION() MLX_PROFILE_SCOPE(MLX_FUNC_SIG)
+	#define MLX_PROFILE_COUNTER(name, value) ::mlx::Profiler::get().appendCounter(name, value)
 #else
 	#define MLX_PROFILE_SCOPE(name)
 	#define MLX_PROFILE_FUNCTION()
+	#define MLX_PROFILE_COUNTER(name, value)
 #endif
 
 #endif
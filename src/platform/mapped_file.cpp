@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mapped_file.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:13:36 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:16:24 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <platform/mapped_file.h>
+#include <core/profiler.h>
+
+#ifdef MLX_PLAT_WINDOWS
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace mlx
+{
+	bool MappedFile::open(const std::filesystem::path& path) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		close();
+		#ifdef MLX_PLAT_WINDOWS
+			HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if(file == INVALID_HANDLE_VALUE)
+				return false;
+			LARGE_INTEGER size;
+			if(!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+			{
+				CloseHandle(file);
+				return false;
+			}
+			HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if(mapping == nullptr)
+			{
+				CloseHandle(file);
+				return false;
+			}
+			void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if(data == nullptr)
+			{
+				CloseHandle(mapping);
+				CloseHandle(file);
+				return false;
+			}
+			_file = file;
+			_mapping = mapping;
+			_size = static_cast<std::size_t>(size.QuadPart);
+		#else
+			int fd = ::open(path.c_str(), O_RDONLY);
+			if(fd < 0)
+				return false;
+			struct stat st;
+			if(fstat(fd, &st) != 0 || st.st_size <= 0)
+			{
+				::close(fd);
+				return false;
+			}
+			void* data = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			::close(fd); // the mapping keeps the file alive
+			if(data == MAP_FAILED)
+				return false;
+			_size = static_cast<std::size_t>(st.st_size);
+			#ifdef POSIX_MADV_SEQUENTIAL
+				posix_madvise(data, _size, POSIX_MADV_SEQUENTIAL);
+			#endif
+		#endif
+		_data = static_cast<const std::uint8_t*>(data);
+		return true;
+	}
+
+	void MappedFile::close() noexcept
+	{
+		if(_data == nullptr)
+			return;
+		#ifdef MLX_PLAT_WINDOWS
+			UnmapViewOfFile(_data);
+			CloseHandle(_mapping);
+			CloseHandle(_file);
+			_mapping = nullptr;
+			_file = nullptr;
+		#else
+			munmap(const_cast<std::uint8_t*>(_data), _size);
+		#endif
+		_data = nullptr;
+		_size = 0;
+	}
+}
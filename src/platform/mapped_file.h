@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mapped_file.h                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:13:36 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:16:24 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_MAPPED_FILE__
+#define __MLX_MAPPED_FILE__
+
+#include <mlx_profile.h>
+#include <filesystem>
+#include <cstdint>
+#include <cstddef>
+
+namespace mlx
+{
+	// Read-only view of a whole file mapped in memory
+	class MappedFile
+	{
+		public:
+			MappedFile() = default;
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			bool open(const std::filesystem::path& path) noexcept;
+			void close() noexcept;
+
+			inline const std::uint8_t* data() const noexcept { return _data; }
+			inline std::size_t size() const noexcept { return _size; }
+			inline bool isOpen() const noexcept { return _data != nullptr; }
+
+			~MappedFile() { close(); }
+
+		private:
+			const std::uint8_t* _data = nullptr;
+			std::size_t _size = 0;
+			#ifdef MLX_PLAT_WINDOWS
+				void* _file = nullptr;
+				void* _mapping = nullptr;
+			#endif
+	};
+}
+
+#endif
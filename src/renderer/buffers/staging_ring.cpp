@@ -0,0 +1,206 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   staging_ring.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:46:02 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:32:57 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#include <renderer/buffers/staging_ring.h>
+#include <renderer/core/render_core.h>
+#include <renderer/command/vk_cmd_buffer.h>
+#include <core/profiler.h>
+#include <algorithm>
+#include <cstring>
+
+namespace mlx
+{
+	void StagingRing::init()
+	{
+		MLX_PROFILE_FUNCTION();
+		#ifdef DEBUG
+			_buffer.create(Buffer::kind::dynamic, SIZE, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, "__mlx_staging_ring");
+		#else
+			_buffer.create(Buffer::kind::dynamic, SIZE, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, nullptr);
+		#endif
+		_buffer.mapMem(reinterpret_cast<void**>(&_map));
+		_fences.resize(FENCES_CAPACITY);
+		_fences_first = 0;
+		_fences_count = 0;
+		_head = 0;
+		_tail = 0;
+		_used = 0;
+		_open = 0;
+		_open_serial = 0;
+	}
+
+	StagingRing::Allocation StagingRing::allocate(VkDeviceSize size, VkDeviceSize alignment, CmdBuffer* recording)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(recording != nullptr && std::find(_recording.begin(), _recording.end(), recording) == _recording.end())
+			_recording.push_back(recording);
+		reclaim();
+		VkDeviceSize offset = 0;
+		if(!tryAllocate(size, alignment, offset))
+		{
+			if(_fences_count == 0)
+				return allocateOverflow(size);
+			// the fences of asynchronous uploads may have signaled without being looked at yet
+			Render_Core::get().getSingleTimeCmdManager().updateSingleTimesCmdBuffersSubmitState();
+			reclaim();
+			if(!tryAllocate(size, alignment, offset))
+				return allocateOverflow(size);
+		}
+		return Allocation{ &_buffer, offset, size, _map + offset };
+	}
+
+	bool StagingRing::tryAllocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset)
+	{
+		if(_used == 0)
+		{
+			_head = 0;
+			_tail = 0;
+		}
+
+		offset = (_head + alignment - 1) / alignment * alignment;
+		if(_used == 0 || _head > _tail)
+		{
+			if(offset + size > SIZE)
+			{
+				if(size > _tail) // no room before the tail either
+					return false;
+				// wraps around, the end of the ring is lost until the tail passes it
+				_used += SIZE - _head;
+				_open += SIZE - _head;
+				_head = 0;
+				offset = 0;
+			}
+		}
+		else if(offset + size > _tail)
+			return false;
+
+		_used += offset + size - _head;
+		_open += offset + size - _head;
+		_head = offset + size;
+		return true;
+	}
+
+	StagingRing::Allocation StagingRing::upload(const void* data, VkDeviceSize size, VkDeviceSize alignment)
+	{
+		Allocation allocation = allocate(size, alignment);
+		std::memcpy(allocation.data, data, size);
+		flush(allocation);
+		return allocation;
+	}
+
+	void StagingRing::flush(const Allocation& allocation)
+	{
+		allocation.buffer->flush(allocation.size, allocation.offset);
+	}
+
+	StagingRing::Allocation StagingRing::allocateOverflow(VkDeviceSize size)
+	{
+		MLX_PROFILE_FUNCTION();
+		// too big for the free space of the ring, the buffer lives until its copy is done
+		Overflow& overflow = _overflows.emplace_back();
+		#ifdef DEBUG
+			overflow.buffer.create(Buffer::kind::dynamic, std::max<VkDeviceSize>(size, 1), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, "__mlx_staging_overflow");
+		#else
+			overflow.buffer.create(Buffer::kind::dynamic, std::max<VkDeviceSize>(size, 1), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, nullptr);
+		#endif
+		void* data = nullptr;
+		overflow.buffer.mapMem(&data);
+		_overflow_count++;
+		return Allocation{ &overflow.buffer, 0, size, data };
+	}
+
+	void StagingRing::release(std::uint64_t serial)
+	{
+		MLX_PROFILE_FUNCTION();
+		_open_serial = std::max(_open_serial, serial);
+		if(_recording.empty())
+			close(_open_serial);
+	}
+
+	void StagingRing::release(CmdBuffer& cmd)
+	{
+		MLX_PROFILE_FUNCTION();
+		auto it = std::find(_recording.begin(), _recording.end(), &cmd);
+		if(it != _recording.end())
+			_recording.erase(it);
+		_open_serial = std::max(_open_serial, cmd.getSubmissionSerial());
+		if(_recording.empty())
+			close(_open_serial);
+	}
+
+	void StagingRing::close(std::uint64_t serial)
+	{
+		// submissions complete in order, the latest one covers everything allocated since the last close
+		if(_open != 0)
+		{
+			pushFence(serial, _head, _open);
+			_open = 0;
+		}
+		for(Overflow& overflow : _overflows)
+		{
+			if(overflow.serial == 0)
+				overflow.serial = serial;
+		}
+		_open_serial = 0;
+	}
+
+	void StagingRing::pushFence(std::uint64_t serial, VkDeviceSize end, VkDeviceSize bytes)
+	{
+		if(_fences_count == _fences.size())
+		{
+			// more submissions in flight than ever before, unrolls the ring into a bigger one
+			std::vector<Fence> fences(_fences.size() * 2);
+			for(std::size_t i = 0; i < _fences_count; i++)
+				fences[i] = _fences[(_fences_first + i) % _fences.size()];
+			_fences.swap(fences);
+			_fences_first = 0;
+		}
+		_fences[(_fences_first + _fences_count) % _fences.size()] = Fence{ serial, end, bytes };
+		_fences_count++;
+	}
+
+	void StagingRing::reclaim()
+	{
+		std::uint64_t completed = Render_Core::get().getDeletionQueue().getLastCompleted();
+		while(_fences_count != 0 && _fences[_fences_first].serial <= completed)
+		{
+			const Fence& fence = _fences[_fences_first];
+			_tail = fence.end;
+			_used -= fence.bytes;
+			_fences_first = (_fences_first + 1) % _fences.size();
+			_fences_count--;
+		}
+		for(auto it = _overflows.begin(); it != _overflows.end();)
+		{
+			if(it->serial != 0 && it->serial <= completed)
+			{
+				it->buffer.destroy();
+				it = _overflows.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	void StagingRing::destroy() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		for(Overflow& overflow : _overflows)
+			overflow.buffer.destroy();
+		_overflows.clear();
+		_fences.clear();
+		_fences_first = 0;
+		_fences_count = 0;
+		_recording.clear();
+		_buffer.destroy();
+		_map = nullptr;
+	}
+}
@@ -0,0 +1,107 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   staging_ring.h                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:46:01 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:32:57 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#ifndef __MLX_STAGING_RING__
+#define __MLX_STAGING_RING__
+
+#include <mlx_profile.h>
+#include <volk.h>
+#include <cstdint>
+#include <list>
+#include <vector>
+#include <renderer/buffers/vk_buffer.h>
+#include <utils/singleton.h>
+
+namespace mlx
+{
+	/**
+	 * Persistently mapped staging memory shared by every upload.
+	 * Allocations are carved linearly out of one ring buffer. Once the copies
+	 * reading them are submitted, `release` tags them with the submission
+	 * serial and they are reused when the deletion queue sees that serial
+	 * complete. Uploads bigger than the free space get a buffer of their own.
+	 * Allocations must be released by the first submission following them.
+	 * Allocations copied from a command buffer that is still recording, like
+	 * the frame ones, are given that command buffer. The allocations around
+	 * them are then only released once it has been submitted as well.
+	 */
+	class StagingRing : public Singleton<StagingRing>
+	{
+		friend class Singleton<StagingRing>;
+
+		public:
+			static constexpr VkDeviceSize SIZE = 32 * 1024 * 1024; // room for the full window updates of every frame in flight
+			static constexpr VkDeviceSize DEFAULT_ALIGNMENT = 16; // covers the texel sizes of every format used
+			static constexpr std::size_t FENCES_CAPACITY = 256; // pending submissions before the fence ring has to grow
+
+			struct Allocation
+			{
+				Buffer* buffer = nullptr;
+				VkDeviceSize offset = 0;
+				VkDeviceSize size = 0;
+				void* data = nullptr;
+			};
+
+		public:
+			void init();
+			void destroy() noexcept;
+
+			Allocation allocate(VkDeviceSize size, VkDeviceSize alignment = DEFAULT_ALIGNMENT, class CmdBuffer* recording = nullptr);
+			Allocation upload(const void* data, VkDeviceSize size, VkDeviceSize alignment = DEFAULT_ALIGNMENT);
+			// makes the CPU writes visible to the GPU, to call before submitting the copies
+			void flush(const Allocation& allocation);
+			void release(std::uint64_t serial); // after a single time submission
+			void release(class CmdBuffer& cmd); // after the submission of a command buffer given to allocate
+
+			inline std::uint64_t getOverflowCount() const noexcept { return _overflow_count; }
+
+		private:
+			StagingRing() = default;
+			~StagingRing() = default;
+
+			void reclaim();
+			void close(std::uint64_t serial);
+			void pushFence(std::uint64_t serial, VkDeviceSize end, VkDeviceSize bytes);
+			bool tryAllocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+			Allocation allocateOverflow(VkDeviceSize size);
+
+		private:
+			struct Fence
+			{
+				std::uint64_t serial;
+				VkDeviceSize end;
+				VkDeviceSize bytes; // allocated bytes and alignment padding
+			};
+
+			struct Overflow
+			{
+				Buffer buffer;
+				std::uint64_t serial = 0; // 0 until released
+			};
+
+		private:
+			Buffer _buffer;
+			std::vector<Fence> _fences; // circular, reserved once so that steady state frames do not allocate
+			std::size_t _fences_first = 0;
+			std::size_t _fences_count = 0;
+			std::list<Overflow> _overflows; // node stable, the command buffers keep pointers to the buffers
+			std::vector<class CmdBuffer*> _recording; // not submitted yet, keep the open allocations from being released
+			std::uint8_t* _map = nullptr;
+			VkDeviceSize _head = 0; // next byte to allocate
+			VkDeviceSize _tail = 0; // oldest byte still in use
+			VkDeviceSize _used = 0;
+			VkDeviceSize _open = 0; // bytes allocated since the last release
+			std::uint64_t _open_serial = 0; // latest submission reading the open allocations
+			std::uint64_t _overflow_count = 0;
+	};
+}
+
+#endif
@@ -6,11 +6,12 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/08 18:55:57 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:28:35 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:50:50 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "vk_buffer.h"
+#include "staging_ring.h"
 #include <renderer/command/vk_cmd_pool.h>
 #include <renderer/command/vk_cmd_buffer.h>
 #include <renderer/core/render_core.h>
@@ -31,12 +32,25 @@ namespace mlx
 				core::error::report(e_kind::warning, "Vulkan : trying to create constant buffer without data (constant buffers cannot be modified after creation)");
 				return;
 			}
-			_usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+			// created straight in device memory and filled from the staging ring
+			_usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			VmaAllocationCreateInfo alloc_info{};
+			alloc_info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+			createBuffer(_usage, alloc_info, size, name);
+			if(data != nullptr)
+				upload(data, size);
+			return;
 		}
 
 		VmaAllocationCreateInfo alloc_info{};
 		alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
 		alloc_info.usage = VMA_MEMORY_USAGE_AUTO;
+		if(type == Buffer::kind::readback)
+		{
+			// the CPU reads these back, so prefer cached memory over write-combined
+			alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+			_usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		}
 
 		createBuffer(_usage, alloc_info, size, name);
 
@@ -46,8 +60,6 @@ namespace mlx
 			mapMem(&mapped);
 				std::memcpy(mapped, data, size);
 			unmapMem();
-			if(type == Buffer::kind::constant || type == Buffer::kind::dynamic_device_local)
-				pushToGPU();
 		}
 	}
 
@@ -111,57 +123,40 @@ namespace mlx
 		return true;
 	}
 
-	void Buffer::pushToGPU() noexcept
+	bool Buffer::upload(const void* data, VkDeviceSize size, VkDeviceSize offset) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		VmaAllocationCreateInfo alloc_info{};
-		alloc_info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
-
-		Buffer newBuffer;
-		newBuffer._usage = (_usage & 0xFFFFFFFC) | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-		#ifdef DEBUG
-			std::string new_name = _name + "_GPU";
-			newBuffer.createBuffer(newBuffer._usage, alloc_info, _size, new_name.c_str());
-		#else
-			newBuffer.createBuffer(newBuffer._usage, alloc_info, _size, nullptr);
-		#endif
-
-		if(newBuffer.copyFromBuffer(*this)) // if the copy succeded we swap the buffers, otherwise the new one is deleted
-			this->swap(newBuffer);
-		newBuffer.destroy();
-	}
-
-	void Buffer::swap(Buffer& buffer) noexcept
-	{
-		VkBuffer temp_b = _buffer;
-		_buffer = buffer._buffer;
-		buffer._buffer = temp_b;
-
-		VmaAllocation temp_a = buffer._allocation;
-		buffer._allocation = _allocation;
-		_allocation = temp_a;
-
-		VkDeviceSize temp_size = buffer._size;
-		buffer._size = _size;
-		_size = temp_size;
+		if(!(_usage & VK_BUFFER_USAGE_TRANSFER_DST_BIT))
+		{
+			core::error::report(e_kind::error, "Vulkan : buffer cannot be uploaded to because it does not have the correct usage flag");
+			return false;
+		}
+		if(offset + size > _size)
+		{
+			core::error::report(e_kind::error, "Vulkan : trying to upload out of the bounds of a buffer");
+			return false;
+		}
 
-		VkDeviceSize temp_offset = buffer._offset;
-		buffer._offset = _offset;
-		_offset = temp_offset;
+		StagingRing& ring = StagingRing::get();
+		StagingRing::Allocation staging = ring.upload(data, size);
 
-		VkBufferUsageFlags temp_u = _usage;
-		_usage = buffer._usage;
-		buffer._usage = temp_u;
+		CmdBuffer& cmd = Render_Core::get().getSingleTimeCmdBuffer();
+		cmd.beginRecord();
+		cmd.copyBuffer(*this, *staging.buffer, staging.offset, offset, size);
+		cmd.endRecord();
+		cmd.submitIdle();
 
-		#ifdef DEBUG
-			std::string temp_n = _name;
-			_name = buffer._name;
-			buffer._name = temp_n;
-		#endif
+		ring.release(cmd.getSubmissionSerial());
+		return true;
 	}
 
 	void Buffer::flush(VkDeviceSize size, VkDeviceSize offset)
 	{
 		Render_Core::get().getAllocator().flush(_allocation, size, offset);
 	}
+
+	void Buffer::invalidate(VkDeviceSize size, VkDeviceSize offset)
+	{
+		Render_Core::get().getAllocator().invalidate(_allocation, size, offset);
+	}
 }
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 23:18:52 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/11 05:16:58 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:50:50 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -23,7 +23,7 @@ namespace mlx
 	class Buffer : public CmdResource
 	{
 		public:
-			enum class kind { dynamic, dynamic_device_local, uniform, constant };
+			enum class kind { dynamic, dynamic_device_local, uniform, constant, readback };
 
 			void create(kind type, VkDeviceSize size, VkBufferUsageFlags usage, const char* name, const void* data = nullptr);
 			void destroy() noexcept;
@@ -33,17 +33,16 @@ namespace mlx
 			inline void unmapMem() noexcept { Render_Core::get().getAllocator().unmapMemory(_allocation); _is_mapped = false; }
 
 			void flush(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+			void invalidate(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
 			bool copyFromBuffer(const Buffer& buffer) noexcept;
+			// copies through the staging ring, the buffer must be a transfer destination
+			bool upload(const void* data, VkDeviceSize size, VkDeviceSize offset = 0) noexcept;
 
 			inline VkBuffer& operator()() noexcept { return _buffer; }
 			inline VkBuffer& get() noexcept { return _buffer; }
 			inline VkDeviceSize getSize() const noexcept { return _size; }
 			inline VkDeviceSize getOffset() const noexcept { return _offset; }
 
-		protected:
-			void pushToGPU() noexcept;
-			void swap(Buffer& buffer) noexcept;
-
 		protected:
 			VmaAllocation _allocation;
 			VkBuffer _buffer = VK_NULL_HANDLE;
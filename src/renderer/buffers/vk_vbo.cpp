@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:28:08 by maldavid          #+#    #+#             */
-/*   Updated: 2023/12/12 22:17:14 by kbz_8            ###   ########.fr       */
+/*   Updated: 2026/10/16 23:50:50 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -41,15 +41,11 @@ namespace mlx
 		}
 
 		if(data == nullptr)
+		{
 			core::error::report(e_kind::warning, "Vulkan : mapping null data in a vertex buffer");
+			return;
+		}
 
-		Buffer tmp_buf;
-		#ifdef DEBUG
-			tmp_buf.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, "tmp_buffer", data);
-		#else
-			tmp_buf.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, nullptr, data);
-		#endif
-		copyFromBuffer(tmp_buf);
-		tmp_buf.destroy();
+		upload(data, size);
 	}
 }
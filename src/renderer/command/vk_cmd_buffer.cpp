@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:26:06 by maldavid          #+#    #+#             */
-/*   Updated: 2024/02/25 08:02:26 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:50:50 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -111,6 +111,11 @@ namespace mlx
 	}
 
 	void CmdBuffer::copyBuffer(Buffer& dst, Buffer& src) noexcept
+	{
+		copyBuffer(dst, src, 0, 0, src.getSize());
+	}
+
+	void CmdBuffer::copyBuffer(Buffer& dst, Buffer& src, VkDeviceSize src_offset, VkDeviceSize dst_offset, VkDeviceSize size) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
 		if(!isRecording())
@@ -122,7 +127,9 @@ namespace mlx
 		preTransferBarrier();
 
 		VkBufferCopy copyRegion{};
-		copyRegion.size = src.getSize();
+		copyRegion.srcOffset = src_offset;
+		copyRegion.dstOffset = dst_offset;
+		copyRegion.size = size;
 		vkCmdCopyBuffer(_cmd_buffer, src.get(), dst.get(), 1, &copyRegion);
 
 		postTransferBarrier();
@@ -135,15 +142,6 @@ namespace mlx
 
 	void CmdBuffer::copyBufferToImage(Buffer& buffer, Image& image) noexcept
 	{
-		MLX_PROFILE_FUNCTION();
-		if(!isRecording())
-		{
-			core::error::report(e_kind::warning, "Vulkan : trying to do a buffer to image copy in a non recording command buffer");
-			return;
-		}
-		
-		preTransferBarrier();
-
 		VkBufferImageCopy region{};
 		region.bufferOffset = 0;
 		region.bufferRowLength = 0;
@@ -154,8 +152,23 @@ namespace mlx
 		region.imageSubresource.layerCount = 1;
 		region.imageOffset = { 0, 0, 0 };
 		region.imageExtent = { image.getWidth(), image.getHeight(), 1 };
+		copyBufferToImage(buffer, image, { region });
+	}
+
+	void CmdBuffer::copyBufferToImage(Buffer& buffer, Image& image, const std::vector<VkBufferImageCopy>& regions) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!isRecording())
+		{
+			core::error::report(e_kind::warning, "Vulkan : trying to do a buffer to image copy in a non recording command buffer");
+			return;
+		}
+		if(regions.empty())
+			return;
+
+		preTransferBarrier();
 
-		vkCmdCopyBufferToImage(_cmd_buffer, buffer.get(), image.get(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+		vkCmdCopyBufferToImage(_cmd_buffer, buffer.get(), image.get(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<std::uint32_t>(regions.size()), regions.data());
 
 		postTransferBarrier();
 
@@ -277,6 +290,7 @@ namespace mlx
 		VkResult res = vkQueueSubmit(Render_Core::get().getQueue().getGraphic(), 1, &submitInfo, _fence.get());
 		if(res != VK_SUCCESS)
 			core::error::report(e_kind::fatal_error, "Vulkan error : failed to submit a single time command buffer, %s", RCore::verbaliseResultVk(res));
+		_submission_serial = Render_Core::get().getDeletionQueue().registerSubmission();
 		_state = state::submitted;
 
 		if(shouldWaitForExecution)
@@ -316,6 +330,7 @@ namespace mlx
 		VkResult res = vkQueueSubmit(Render_Core::get().getQueue().getGraphic(), 1, &submitInfo, _fence.get());
 		if(res != VK_SUCCESS)
 			core::error::report(e_kind::fatal_error, "Vulkan error : failed to submit draw command buffer, %s", RCore::verbaliseResultVk(res));
+		_submission_serial = Render_Core::get().getDeletionQueue().registerSubmission();
 		_state = state::submitted;
 	}
 
@@ -325,6 +340,7 @@ namespace mlx
 		if(!_fence.isReady())
 			return;
 
+		Render_Core::get().getDeletionQueue().submissionCompleted(_submission_serial);
 		for(CmdResource* res : _cmd_resources)
 			res->removedFromCmdBuffer();
 		_cmd_resources.clear();
@@ -6,7 +6,7 @@
 /*   By: bonsthie <bonsthie@42angouleme.fr>         +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:25:42 by maldavid          #+#    #+#             */
-/*   Updated: 2024/08/08 17:46:00 by bonsthie         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:50:50 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -58,7 +58,9 @@ namespace mlx
 			void bindVertexBuffer(Buffer& buffer) noexcept;
 			void bindIndexBuffer(Buffer& buffer) noexcept;
 			void copyBuffer(Buffer& dst, Buffer& src) noexcept;
+			void copyBuffer(Buffer& dst, Buffer& src, VkDeviceSize src_offset, VkDeviceSize dst_offset, VkDeviceSize size) noexcept;
 			void copyBufferToImage(Buffer& buffer, Image& image) noexcept;
+			void copyBufferToImage(Buffer& buffer, Image& image, const std::vector<VkBufferImageCopy>& regions) noexcept;
 			void copyImagetoBuffer(Image& image, Buffer& buffer) noexcept;
 			void transitionImageLayout(Image& image, VkImageLayout new_layout) noexcept;
 
@@ -71,6 +73,7 @@ namespace mlx
 			inline VkCommandBuffer& operator()() noexcept { return _cmd_buffer; }
 			inline VkCommandBuffer& get() noexcept { return _cmd_buffer; }
 			inline Fence& getFence() noexcept { return _fence; }
+			inline std::uint64_t getSubmissionSerial() const noexcept { return _submission_serial; }
 
 		private:
 			void preTransferBarrier() noexcept;
@@ -81,6 +84,7 @@ namespace mlx
 			Fence _fence;
 			VkCommandBuffer _cmd_buffer = VK_NULL_HANDLE;
 			class CmdPool* _pool = nullptr;
+			std::uint64_t _submission_serial = 0;
 			state _state = state::uninit;
 			kind _type;
 	};
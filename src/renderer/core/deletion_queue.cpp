@@ -0,0 +1,46 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   deletion_queue.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 22:53:03 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 22:53:47 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <renderer/core/deletion_queue.h>
+#include <core/profiler.h>
+
+namespace mlx
+{
+	void DeletionQueue::push(std::function<void()> deleter)
+	{
+		if(_last_completed >= _last_submitted) // nothing in flight
+			deleter();
+		else
+			_deleters.emplace_back(_last_submitted, std::move(deleter));
+	}
+
+	void DeletionQueue::collect()
+	{
+		MLX_PROFILE_FUNCTION();
+		while(!_deleters.empty() && _deleters.front().first <= _last_completed)
+		{
+			_deleters.front().second();
+			_deleters.pop_front();
+		}
+	}
+
+	void DeletionQueue::flush()
+	{
+		MLX_PROFILE_FUNCTION();
+		while(!_deleters.empty())
+		{
+			_deleters.front().second();
+			_deleters.pop_front();
+		}
+		_last_completed = _last_submitted;
+	}
+}
@@ -0,0 +1,54 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   deletion_queue.h                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 22:53:03 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:50:50 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_DELETION_QUEUE__
+#define __MLX_DELETION_QUEUE__
+
+#include <mlx_profile.h>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+namespace mlx
+{
+	/**
+	 * Delays the destruction of GPU objects until every queue submission that
+	 * could still use them has completed.
+	 * Each submission to the graphics queue gets a serial. As fence signals on a
+	 * queue also cover all the earlier submissions of that queue, seeing one
+	 * signaled fence tells that every submission up to its serial is done.
+	 * Objects must not be destroyed while recorded in a command buffer that
+	 * has not been submitted yet.
+	 */
+	class DeletionQueue
+	{
+		public:
+			DeletionQueue() = default;
+
+			inline std::uint64_t registerSubmission() noexcept { return ++_last_submitted; }
+			inline void submissionCompleted(std::uint64_t serial) noexcept { if(serial > _last_completed) _last_completed = serial; }
+			inline std::uint64_t getLastCompleted() const noexcept { return _last_completed; }
+
+			void push(std::function<void()> deleter);
+			void collect(); // destroys everything that is not used by the GPU anymore
+			void flush(); // destroys everything, the device must be idle
+
+			~DeletionQueue() = default;
+
+		private:
+			std::deque<std::pair<std::uint64_t, std::function<void()>>> _deleters;
+			std::uint64_t _last_submitted = 0;
+			std::uint64_t _last_completed = 0;
+	};
+}
+
+#endif
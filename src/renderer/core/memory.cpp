@@ -6,7 +6,7 @@
 /*   By: kbz_8 <kbz_8.dev@akel-engine.com>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/10/20 22:02:37 by kbz_8             #+#    #+#             */
-/*   Updated: 2024/03/14 16:34:53 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:20:54 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -106,12 +106,14 @@ namespace mlx
 	void GPUallocator::destroyBuffer(VmaAllocation allocation, VkBuffer buffer) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		vkDeviceWaitIdle(Render_Core::get().getDevice().get());
-		vmaDestroyBuffer(_allocator, buffer, allocation);
-		#ifdef DEBUG
-			core::error::report(e_kind::message, "Graphics Allocator : destroyed buffer");
-		#endif
-		_active_buffers_allocations--;
+		Render_Core::get().getDeletionQueue().push([this, allocation, buffer]()
+		{
+			vmaDestroyBuffer(_allocator, buffer, allocation);
+			#ifdef DEBUG
+				core::error::report(e_kind::message, "Graphics Allocator : destroyed buffer");
+			#endif
+			_active_buffers_allocations--;
+		});
 	}
 
 	VmaAllocation GPUallocator::createImage(const VkImageCreateInfo* iminfo, const VmaAllocationCreateInfo* vinfo, VkImage& image, const char* name) noexcept
@@ -136,12 +138,14 @@ namespace mlx
 	void GPUallocator::destroyImage(VmaAllocation allocation, VkImage image) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		vkDeviceWaitIdle(Render_Core::get().getDevice().get());
-		vmaDestroyImage(_allocator, image, allocation);
-		#ifdef DEBUG
-			core::error::report(e_kind::message, "Graphics Allocator : destroyed image");
-		#endif
-		_active_images_allocations--;
+		Render_Core::get().getDeletionQueue().push([this, allocation, image]()
+		{
+			vmaDestroyImage(_allocator, image, allocation);
+			#ifdef DEBUG
+				core::error::report(e_kind::message, "Graphics Allocator : destroyed image");
+			#endif
+			_active_images_allocations--;
+		});
 	}
 
 	void GPUallocator::mapMemory(VmaAllocation allocation, void** data) noexcept
@@ -183,6 +187,12 @@ namespace mlx
 		vmaFlushAllocation(_allocator, allocation, offset, size);
 	}
 
+	void GPUallocator::invalidate(VmaAllocation allocation, VkDeviceSize size, VkDeviceSize offset) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		vmaInvalidateAllocation(_allocator, allocation, offset, size);
+	}
+
 	void GPUallocator::destroy() noexcept
 	{
 		if(_active_images_allocations != 0)
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/10/20 02:13:03 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:01:06 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:20:54 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -39,6 +39,7 @@ namespace mlx
 			void dumpMemoryToJson();
 
 			void flush(VmaAllocation allocation, VkDeviceSize size, VkDeviceSize offset) noexcept;
+			void invalidate(VmaAllocation allocation, VkDeviceSize size, VkDeviceSize offset) noexcept;
 
 			~GPUallocator() = default;
 
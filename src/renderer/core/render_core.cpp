@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/12/17 23:33:34 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/20 08:20:07 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:20:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,6 +15,7 @@
 #include <mlx_profile.h>
 #include <renderer/core/render_core.h>
 #include <renderer/command/vk_cmd_buffer.h>
+#include <renderer/buffers/staging_ring.h>
 
 #ifdef DEBUG
 	#ifdef MLX_COMPILER_MSVC
@@ -114,8 +115,9 @@ namespace mlx
 		}
 	}
 
-	void Render_Core::init()
+	void Render_Core::init(bool headless)
 	{
+		_headless = headless;
 		if(volkInitialize() != VK_SUCCESS)
 			core::error::report(e_kind::fatal_error, "Vulkan loader : cannot load %s, are you sure Vulkan is installed on your system ?", VULKAN_LIB_NAME);
 
@@ -127,6 +129,9 @@ namespace mlx
 		_queues.init();
 		_allocator.init();
 		_cmd_manager.init();
+		StagingRing::get().init();
+		_pipeline_cache.init();
+		_texture_table.init();
 		_is_init = true;
 	}
 
@@ -137,6 +142,11 @@ namespace mlx
 
 		vkDeviceWaitIdle(_device());
 
+		StagingRing::get().destroy();
+		_deletion_queue.flush();
+		_texture_table.destroy();
+		_sampler_cache.destroy();
+		_pipeline_cache.destroy();
 		_pool_manager.destroyAllPools();
 		_cmd_manager.destroy();
 		_allocator.destroy();
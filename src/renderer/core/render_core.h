@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/08 19:16:32 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/20 08:17:58 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:20:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -20,11 +20,15 @@
 #include <renderer/command/single_time_cmd_manager.h>
 #include <renderer/descriptors/descriptor_pool_manager.h>
 #include <renderer/descriptors/vk_descriptor_pool.h>
+#include <renderer/descriptors/texture_table.h>
 #include "vk_queues.h"
 #include "vk_device.h"
 #include "vk_instance.h"
 #include "vk_validation_layers.h"
 #include "memory.h"
+#include "deletion_queue.h"
+#include <renderer/images/sampler_cache.h>
+#include <renderer/pipeline/pipeline_cache.h>
 
 #include <utils/singleton.h>
 #include <core/errors.h>
@@ -55,14 +59,19 @@ namespace mlx
 		friend class Singleton<Render_Core>;
 
 		public:
-			void init();
+			void init(bool headless = false); // headless cores have no surface support and only render into images
 			void destroy();
 
 			inline bool isInit() const noexcept { return _is_init; }
+			inline bool isHeadless() const noexcept { return _headless; }
 			inline Instance& getInstance() noexcept { return _instance; }
 			inline Device& getDevice() noexcept { return _device; }
 			inline Queues& getQueue() noexcept { return _queues; }
 			inline GPUallocator& getAllocator() noexcept { return _allocator; }
+			inline DeletionQueue& getDeletionQueue() noexcept { return _deletion_queue; }
+			inline SamplerCache& getSamplerCache() noexcept { return _sampler_cache; }
+			inline PipelineCache& getPipelineCache() noexcept { return _pipeline_cache; }
+			inline TextureTable& getTextureTable() noexcept { return _texture_table; }
 			inline ValidationLayers& getLayers() noexcept { return _layers; }
 			inline CmdBuffer& getSingleTimeCmdBuffer() noexcept { return _cmd_manager.getCmdBuffer(); }
 			inline SingleTimeCmdManager& getSingleTimeCmdManager() noexcept { return _cmd_manager; }
@@ -80,7 +89,12 @@ namespace mlx
 			Device _device;
 			Instance _instance;
 			GPUallocator _allocator;
+			DeletionQueue _deletion_queue;
+			SamplerCache _sampler_cache;
+			PipelineCache _pipeline_cache;
+			TextureTable _texture_table;
 			bool _is_init = false;
+			bool _headless = false;
 	};
 }
 
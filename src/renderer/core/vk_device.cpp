@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/08 19:14:29 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:23:45 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:20:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -22,6 +22,11 @@ namespace mlx
 {
 	const std::vector<const char*> deviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
 
+	static inline std::uint32_t requiredExtensionsCount() noexcept
+	{
+		return Render_Core::get().isHeadless() ? 0 : static_cast<std::uint32_t>(deviceExtensions.size()); // headless devices never present
+	}
+
 	void Device::init()
 	{
 		pickPhysicalDevice();
@@ -44,15 +49,31 @@ namespace mlx
 
 		VkPhysicalDeviceFeatures deviceFeatures{};
 
+		// descriptor indexing lets all the textures live in a single array indexed from the shaders
+		VkPhysicalDeviceVulkan12Features features12{};
+		features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		_descriptor_indexing = checkDescriptorIndexingSupport(_physical_device);
+		if(_descriptor_indexing)
+		{
+			deviceFeatures.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+			features12.descriptorIndexing = VK_TRUE;
+			features12.runtimeDescriptorArray = VK_TRUE;
+			features12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			features12.descriptorBindingPartiallyBound = VK_TRUE;
+			features12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			features12.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+		}
+
 		VkDeviceCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+		createInfo.pNext = (_descriptor_indexing ? &features12 : nullptr);
 
 		createInfo.queueCreateInfoCount = static_cast<std::uint32_t>(queueCreateInfos.size());
 		createInfo.pQueueCreateInfos = queueCreateInfos.data();
 
 		createInfo.pEnabledFeatures = &deviceFeatures;
 
-		createInfo.enabledExtensionCount = static_cast<std::uint32_t>(deviceExtensions.size());
+		createInfo.enabledExtensionCount = requiredExtensionsCount();
 		createInfo.ppEnabledExtensionNames = deviceExtensions.data();
 		createInfo.enabledLayerCount = 0;
 
@@ -61,6 +82,8 @@ namespace mlx
 			core::error::report(e_kind::fatal_error, "Vulkan : failed to create logcal device, %s", RCore::verbaliseResultVk(res));
 		#ifdef DEBUG
 			core::error::report(e_kind::message, "Vulkan : created new logical device");
+			if(!_descriptor_indexing)
+				core::error::report(e_kind::message, "Vulkan : descriptor indexing is not supported, textures will be bound one by one");
 		#endif
 	}
 
@@ -75,13 +98,17 @@ namespace mlx
 		std::vector<VkPhysicalDevice> devices(deviceCount);
 		vkEnumeratePhysicalDevices(Render_Core::get().getInstance().get(), &deviceCount, devices.data());
 
-		SDL_Window* window = SDL_CreateWindow("", 0, 0, 1, 1, SDL_WINDOW_VULKAN | SDL_WINDOW_HIDDEN);
-		if(!window)
-			core::error::report(e_kind::fatal_error, "Vulkan : failed to create a window to pick physical device");
-
+		SDL_Window* window = nullptr;
 		VkSurfaceKHR surface = VK_NULL_HANDLE;
-		if(SDL_Vulkan_CreateSurface(window, Render_Core::get().getInstance().get(), &surface) != SDL_TRUE)
-			core::error::report(e_kind::fatal_error, "Vulkan : failed to create a surface to pick physical device");
+		if(!Render_Core::get().isHeadless())
+		{
+			window = SDL_CreateWindow("", 0, 0, 1, 1, SDL_WINDOW_VULKAN | SDL_WINDOW_HIDDEN);
+			if(!window)
+				core::error::report(e_kind::fatal_error, "Vulkan : failed to create a window to pick physical device");
+
+			if(SDL_Vulkan_CreateSurface(window, Render_Core::get().getInstance().get(), &surface) != SDL_TRUE)
+				core::error::report(e_kind::fatal_error, "Vulkan : failed to create a surface to pick physical device");
+		}
 
 		std::multimap<int, VkPhysicalDevice> devices_score;
 
@@ -102,8 +129,11 @@ namespace mlx
 			core::error::report(e_kind::message, "Vulkan : picked a physical device, %s", props.deviceName);
 		#endif
 		Render_Core::get().getQueue().findQueueFamilies(_physical_device, surface); // update queue indicies to current physical device
-		vkDestroySurfaceKHR(Render_Core::get().getInstance().get(), surface, nullptr);
-		SDL_DestroyWindow(window);
+		if(window != nullptr)
+		{
+			vkDestroySurfaceKHR(Render_Core::get().getInstance().get(), surface, nullptr);
+			SDL_DestroyWindow(window);
+		}
 	}
 
 	int Device::deviceScore(VkPhysicalDevice device, VkSurfaceKHR surface)
@@ -112,7 +142,9 @@ namespace mlx
 		bool extensionsSupported = checkDeviceExtensionSupport(device);
 
 		std::uint32_t formatCount = 0;
-		if(extensionsSupported)
+		if(surface == VK_NULL_HANDLE)
+			formatCount = 1; // offscreen rendering only, any format the renderer asks for will do
+		else if(extensionsSupported)
 			vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &formatCount, nullptr);
 
 		VkPhysicalDeviceProperties props;
@@ -148,7 +180,7 @@ namespace mlx
 		std::vector<VkExtensionProperties> availableExtensions(extensionCount);
 		vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
 
-		std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
+		std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.begin() + requiredExtensionsCount());
 
 		for(const auto& extension : availableExtensions)
 			requiredExtensions.erase(extension.extensionName);
@@ -156,6 +188,29 @@ namespace mlx
 		return requiredExtensions.empty();
 	}
 
+	bool Device::checkDescriptorIndexingSupport(VkPhysicalDevice device)
+	{
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(device, &props);
+		if(props.apiVersion < VK_API_VERSION_1_2)
+			return false;
+
+		VkPhysicalDeviceVulkan12Features features12{};
+		features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		VkPhysicalDeviceFeatures2 features{};
+		features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		features.pNext = &features12;
+		vkGetPhysicalDeviceFeatures2(device, &features);
+
+		return features.features.shaderSampledImageArrayDynamicIndexing &&
+			features12.descriptorIndexing &&
+			features12.runtimeDescriptorArray &&
+			features12.shaderSampledImageArrayNonUniformIndexing &&
+			features12.descriptorBindingPartiallyBound &&
+			features12.descriptorBindingSampledImageUpdateAfterBind &&
+			features12.descriptorBindingUpdateUnusedWhilePending;
+	}
+
 	void Device::destroy() noexcept
 	{
 		vkDestroyDevice(_device, nullptr);
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/08 19:04:21 by maldavid          #+#    #+#             */
-/*   Updated: 2024/02/24 21:10:32 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:17:28 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -59,6 +59,16 @@ namespace mlx
 	std::vector<const char*> Instance::getRequiredExtensions()
 	{
 		std::vector<const char*> extensions;
+		if(Render_Core::get().isHeadless())
+		{
+			if constexpr(enableValidationLayers)
+			{
+				extensions.push_back(VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
+				extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+			}
+			return extensions;
+		}
+
 		extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
 		
 		#ifdef VK_USE_PLATFORM_XCB_KHR
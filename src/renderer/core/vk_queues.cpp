@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/08 19:02:42 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:01:10 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:17:28 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -32,7 +32,10 @@ namespace mlx
 				_families->graphics_family = i;
 
 			VkBool32 presentSupport = false;
-			vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+			if(surface != VK_NULL_HANDLE)
+				vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+			else if(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+				presentSupport = true; // nothing is presented without surface, the graphics queue takes the role
 
 			if(presentSupport)
 				_families->present_family = i;
@@ -0,0 +1,155 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   texture_table.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 00:12:47 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:20:35 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <renderer/descriptors/texture_table.h>
+#include <renderer/core/render_core.h>
+#include <renderer/images/vk_image.h>
+#include <core/profiler.h>
+#include <algorithm>
+
+namespace mlx
+{
+	void TextureTable::init()
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!Render_Core::get().getDevice().supportsDescriptorIndexing())
+			return;
+
+		VkPhysicalDeviceVulkan12Properties props12{};
+		props12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+		VkPhysicalDeviceProperties2 props{};
+		props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		props.pNext = &props12;
+		vkGetPhysicalDeviceProperties2(Render_Core::get().getDevice().getPhysicalDevice(), &props);
+		// combined image samplers count as much against the sampler limits as against the sampled image ones
+		_capacity = std::min({
+			MAX_TEXTURES,
+			props12.maxPerStageDescriptorUpdateAfterBindSampledImages,
+			props12.maxPerStageDescriptorUpdateAfterBindSamplers,
+			props12.maxDescriptorSetUpdateAfterBindSampledImages,
+			props12.maxDescriptorSetUpdateAfterBindSamplers
+		});
+
+		auto device = Render_Core::get().getDevice().get();
+
+		VkDescriptorSetLayoutBinding binding{};
+		binding.binding = 0;
+		binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		binding.descriptorCount = _capacity;
+		binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		binding.pImmutableSamplers = nullptr;
+
+		VkDescriptorBindingFlags binding_flags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+		VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo{};
+		flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		flagsInfo.bindingCount = 1;
+		flagsInfo.pBindingFlags = &binding_flags;
+
+		VkDescriptorSetLayoutCreateInfo layoutInfo{};
+		layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layoutInfo.pNext = &flagsInfo;
+		layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+		layoutInfo.bindingCount = 1;
+		layoutInfo.pBindings = &binding;
+
+		VkResult res = vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &_layout);
+		if(res != VK_SUCCESS)
+			core::error::report(e_kind::fatal_error, "Vulkan : failed to create the texture table descriptor set layout, %s", RCore::verbaliseResultVk(res));
+
+		VkDescriptorPoolSize size{};
+		size.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		size.descriptorCount = _capacity;
+
+		VkDescriptorPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+		poolInfo.maxSets = 1;
+		poolInfo.poolSizeCount = 1;
+		poolInfo.pPoolSizes = &size;
+
+		res = vkCreateDescriptorPool(device, &poolInfo, nullptr, &_pool);
+		if(res != VK_SUCCESS)
+			core::error::report(e_kind::fatal_error, "Vulkan : failed to create the texture table descriptor pool, %s", RCore::verbaliseResultVk(res));
+
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = _pool;
+		allocInfo.descriptorSetCount = 1;
+		allocInfo.pSetLayouts = &_layout;
+
+		res = vkAllocateDescriptorSets(device, &allocInfo, &_set);
+		if(res != VK_SUCCESS)
+			core::error::report(e_kind::fatal_error, "Vulkan : failed to allocate the texture table descriptor set, %s", RCore::verbaliseResultVk(res));
+		#ifdef DEBUG
+			Render_Core::get().getLayers().setDebugUtilsObjectNameEXT(VK_OBJECT_TYPE_DESCRIPTOR_SET, (std::uint64_t)_set, "__mlx_texture_table");
+			core::error::report(e_kind::message, "Vulkan : created a texture table of %u textures", _capacity);
+		#endif
+	}
+
+	std::uint32_t TextureTable::add(const Image& image)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::uint32_t index;
+		if(!_free_indices.empty())
+		{
+			index = _free_indices.back();
+			_free_indices.pop_back();
+		}
+		else if(_next_index < _capacity)
+			index = _next_index++;
+		else
+			return INVALID_INDEX;
+
+		VkDescriptorImageInfo imageInfo{};
+		imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		imageInfo.imageView = image.getImageView();
+		imageInfo.sampler = image.getSampler();
+
+		VkWriteDescriptorSet descriptorWrite{};
+		descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrite.dstSet = _set;
+		descriptorWrite.dstBinding = 0;
+		descriptorWrite.dstArrayElement = index;
+		descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorWrite.descriptorCount = 1;
+		descriptorWrite.pImageInfo = &imageInfo;
+
+		vkUpdateDescriptorSets(Render_Core::get().getDevice().get(), 1, &descriptorWrite, 0, nullptr);
+		return index;
+	}
+
+	void TextureTable::remove(std::uint32_t index)
+	{
+		if(index == INVALID_INDEX || !isEnabled())
+			return;
+		// frames in flight may still sample the old texture through this slot
+		Render_Core::get().getDeletionQueue().push([this, index]() { _free_indices.push_back(index); });
+	}
+
+	void TextureTable::destroy() noexcept
+	{
+		if(!isEnabled())
+			return;
+		auto device = Render_Core::get().getDevice().get();
+		vkDestroyDescriptorPool(device, _pool, nullptr);
+		vkDestroyDescriptorSetLayout(device, _layout, nullptr);
+		_pool = VK_NULL_HANDLE;
+		_layout = VK_NULL_HANDLE;
+		_set = VK_NULL_HANDLE;
+		_free_indices.clear();
+		_next_index = 0;
+		_capacity = 0;
+		#ifdef DEBUG
+			core::error::report(e_kind::message, "Vulkan : destroyed the texture table");
+		#endif
+	}
+}
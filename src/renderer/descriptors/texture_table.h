@@ -0,0 +1,61 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   texture_table.h                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 00:12:47 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:20:35 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_TEXTURE_TABLE__
+#define __MLX_TEXTURE_TABLE__
+
+#include <mlx_profile.h>
+#include <volk.h>
+#include <vector>
+#include <cstdint>
+
+namespace mlx
+{
+	/**
+	 * Single descriptor set holding an array of every texture, used when the
+	 * device supports descriptor indexing so that sprites only need to push
+	 * the index of their texture instead of binding a set per texture.
+	 * Slots are written while the set may be in use by frames in flight
+	 * (update after bind), a freed slot is only reused once the GPU is done
+	 * with the submissions that could still read it.
+	 */
+	class TextureTable
+	{
+		public:
+			static constexpr std::uint32_t MAX_TEXTURES = 16384;
+			static constexpr std::uint32_t INVALID_INDEX = UINT32_MAX;
+
+		public:
+			TextureTable() = default;
+
+			void init(); // does nothing if descriptor indexing is not supported
+			std::uint32_t add(const class Image& image); // returns INVALID_INDEX if the table is full
+			void remove(std::uint32_t index);
+			void destroy() noexcept;
+
+			inline bool isEnabled() const noexcept { return _set != VK_NULL_HANDLE; }
+			inline VkDescriptorSetLayout getLayout() const noexcept { return _layout; }
+			inline VkDescriptorSet getSet() const noexcept { return _set; }
+
+			~TextureTable() = default;
+
+		private:
+			std::vector<std::uint32_t> _free_indices;
+			VkDescriptorSetLayout _layout = VK_NULL_HANDLE;
+			VkDescriptorPool _pool = VK_NULL_HANDLE;
+			VkDescriptorSet _set = VK_NULL_HANDLE;
+			std::uint32_t _capacity = 0;
+			std::uint32_t _next_index = 0;
+	};
+}
+
+#endif
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/01/23 18:40:44 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/20 08:18:07 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:03:41 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -82,16 +82,19 @@ namespace mlx
 		imageInfo.imageView = image.getImageView();
 		imageInfo.sampler = image.getSampler();
 
-		VkWriteDescriptorSet descriptorWrite{};
-		descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		descriptorWrite.dstSet = _desc_set[_renderer->getActiveImageIndex()];
-		descriptorWrite.dstBinding = binding;
-		descriptorWrite.dstArrayElement = 0;
-		descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-		descriptorWrite.descriptorCount = 1;
-		descriptorWrite.pImageInfo = &imageInfo;
+		std::array<VkWriteDescriptorSet, MAX_FRAMES_IN_FLIGHT> descriptorWrites{};
+		for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+		{
+			descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrites[i].dstSet = _desc_set[i];
+			descriptorWrites[i].dstBinding = binding;
+			descriptorWrites[i].dstArrayElement = 0;
+			descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			descriptorWrites[i].descriptorCount = 1;
+			descriptorWrites[i].pImageInfo = &imageInfo;
+		}
 
-		vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+		vkUpdateDescriptorSets(device, descriptorWrites.size(), descriptorWrites.data(), 0, nullptr);
 	}
 
 	DescriptorSet DescriptorSet::duplicate()
@@ -116,7 +119,7 @@ namespace mlx
 	{
 		MLX_PROFILE_FUNCTION();
 		if(_pool != nullptr && Render_Core::get().isInit()) // checks if the render core is still init (it should always be init but just in case)
-			_pool->freeDescriptor(*this);
+			Render_Core::get().getDeletionQueue().push([pool = _pool, set = *this]() { pool->freeDescriptor(set); });
 		for(auto& set : _desc_set)
 		{
 			if(set != VK_NULL_HANDLE)
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/01/23 18:39:36 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/20 07:17:39 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:03:41 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -28,7 +28,7 @@ namespace mlx
 			void init(class Renderer* renderer, class DescriptorPool* pool, class DescriptorSetLayout* layout);
 
 			void writeDescriptor(int binding, class UBO* ubo) const noexcept;
-			void writeDescriptor(int binding, const class Image& image) const noexcept;
+			void writeDescriptor(int binding, const class Image& image) const noexcept; // writes the sets of all frames, they must not be in use
 
 			inline bool isInit() const noexcept { return _pool != nullptr && _renderer != nullptr; }
 
@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   draw_list.cpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:04:42 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:08:52 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <renderer/draw_list.h>
+#include <core/profiler.h>
+
+namespace mlx
+{
+	void DrawList::push(DrawCommandKind kind, std::uint32_t resource, int x, int y)
+	{
+		MLX_PROFILE_FUNCTION();
+		auto res = _positions.try_emplace(DrawCommandKey{ kind, resource, x, y }, static_cast<std::uint32_t>(_kinds.size()));
+		if(!res.second) // already in the list, kill the old slot
+		{
+			_kinds[res.first->second] = DrawCommandKind::none;
+			res.first->second = static_cast<std::uint32_t>(_kinds.size());
+			_dead++;
+		}
+		_kinds.push_back(kind);
+		_resources.push_back(resource);
+		_xs.push_back(x);
+		_ys.push_back(y);
+
+		if(_dead > _positions.size())
+			compact();
+	}
+
+	void DrawList::eraseResource(DrawCommandKind kind, std::uint32_t resource)
+	{
+		MLX_PROFILE_FUNCTION();
+		for(std::size_t i = 0; i < _kinds.size(); i++)
+		{
+			if(_kinds[i] != kind || _resources[i] != resource)
+				continue;
+			_positions.erase(DrawCommandKey{ kind, resource, _xs[i], _ys[i] });
+			_kinds[i] = DrawCommandKind::none;
+			_dead++;
+		}
+		if(_dead > _positions.size())
+			compact();
+	}
+
+	void DrawList::clear() noexcept
+	{
+		_positions.clear();
+		_kinds.clear();
+		_resources.clear();
+		_xs.clear();
+		_ys.clear();
+		_dead = 0;
+	}
+
+	void DrawList::compact()
+	{
+		MLX_PROFILE_FUNCTION();
+		std::size_t back = 0;
+		for(std::size_t i = 0; i < _kinds.size(); i++)
+		{
+			if(_kinds[i] == DrawCommandKind::none)
+				continue;
+			if(back != i)
+			{
+				_kinds[back] = _kinds[i];
+				_resources[back] = _resources[i];
+				_xs[back] = _xs[i];
+				_ys[back] = _ys[i];
+				_positions[DrawCommandKey{ _kinds[back], _resources[back], _xs[back], _ys[back] }] = static_cast<std::uint32_t>(back);
+			}
+			back++;
+		}
+		_kinds.resize(back);
+		_resources.resize(back);
+		_xs.resize(back);
+		_ys.resize(back);
+		_dead = 0;
+	}
+}
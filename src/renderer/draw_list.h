@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   draw_list.h                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:04:42 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_DRAW_LIST__
+#define __MLX_DRAW_LIST__
+
+#include <mlx_profile.h>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <utils/combine_hash.h>
+#include <utils/pool_allocator.h>
+
+namespace mlx
+{
+	enum class DrawCommandKind : std::uint8_t
+	{
+		none = 0, // erased command, skipped until the next compaction
+		texture,
+		text,
+	};
+
+	struct DrawCommandKey
+	{
+		DrawCommandKind kind;
+		std::uint32_t resource;
+		int x;
+		int y;
+
+		inline bool operator==(const DrawCommandKey& rhs) const noexcept { return kind == rhs.kind && resource == rhs.resource && x == rhs.x && y == rhs.y; }
+	};
+}
+
+namespace std
+{
+	template <>
+	struct hash<mlx::DrawCommandKey>
+	{
+		std::size_t operator()(const mlx::DrawCommandKey& k) const noexcept
+		{
+			std::size_t hash = 0;
+			mlx::hashCombine(hash, static_cast<std::uint8_t>(k.kind), k.resource, k.x, k.y);
+			return hash;
+		}
+	};
+}
+
+namespace mlx
+{
+	/**
+	 * Ordered stream of draw commands stored as a struct of arrays.
+	 * Putting a command that is already in the list moves it to the back in
+	 * constant time: its previous slot is turned into a `none` command and the
+	 * stream is compacted once dead slots outnumber the live ones.
+	 */
+	class DrawList
+	{
+		public:
+			DrawList() = default;
+
+			void push(DrawCommandKind kind, std::uint32_t resource, int x, int y);
+			void eraseResource(DrawCommandKind kind, std::uint32_t resource);
+			void clear() noexcept;
+
+			inline std::size_t size() const noexcept { return _kinds.size(); }
+			inline DrawCommandKind getKind(std::size_t i) const noexcept { return _kinds[i]; }
+			inline std::uint32_t getResource(std::size_t i) const noexcept { return _resources[i]; }
+			inline int getX(std::size_t i) const noexcept { return _xs[i]; }
+			inline int getY(std::size_t i) const noexcept { return _ys[i]; }
+
+			~DrawList() = default;
+
+		private:
+			void compact();
+
+		private:
+			// pooled nodes, the map is cleared and filled again by every frame that clears the window
+			std::unordered_map<DrawCommandKey, std::uint32_t, std::hash<DrawCommandKey>, std::equal_to<DrawCommandKey>, PoolAllocator<std::pair<const DrawCommandKey, std::uint32_t>>> _positions;
+			std::vector<DrawCommandKind> _kinds;
+			std::vector<std::uint32_t> _resources;
+			std::vector<int> _xs;
+			std::vector<int> _ys;
+			std::size_t _dead = 0;
+	};
+}
+
+#endif
@@ -0,0 +1,56 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frame_arena.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:39:45 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#include <renderer/frame_arena.h>
+#include <core/profiler.h>
+#include <algorithm>
+
+namespace mlx
+{
+	void* FrameArena::allocate(std::size_t size, std::size_t alignment)
+	{
+		for(; _chunk < _chunks.size(); _chunk++, _offset = 0)
+		{
+			Chunk& chunk = _chunks[_chunk];
+			std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunk.data.get());
+			std::size_t aligned = ((base + _offset + alignment - 1) & ~(alignment - 1)) - base;
+			if(aligned + size <= chunk.size)
+			{
+				_offset = aligned + size;
+				_used += size;
+				return chunk.data.get() + aligned;
+			}
+		}
+
+		MLX_PROFILE_FUNCTION();
+		// no chunk left for this frame, the new one is kept for the next frames
+		Chunk& chunk = _chunks.emplace_back();
+		chunk.size = std::max(CHUNK_SIZE, size + alignment);
+		chunk.data = std::make_unique<std::byte[]>(chunk.size);
+		_heap_allocations++;
+		_chunk = _chunks.size() - 1;
+		_offset = 0;
+		return allocate(size, alignment);
+	}
+
+	void FrameArena::reset() noexcept
+	{
+		_chunk = 0;
+		_offset = 0;
+		_used = 0;
+	}
+
+	void FrameArena::destroy() noexcept
+	{
+		_chunks.clear();
+		reset();
+	}
+}
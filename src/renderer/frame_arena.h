@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frame_arena.h                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:39:45 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#ifndef __MLX_FRAME_ARENA__
+#define __MLX_FRAME_ARENA__
+
+#include <mlx_profile.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace mlx
+{
+	/**
+	 * Bump allocator for CPU data that does not outlive a frame (text vertices,
+	 * scratch arrays...). It is rewound at the beginning of every frame of its
+	 * renderer and keeps its chunks, so it only reaches the heap while it grows.
+	 */
+	class FrameArena
+	{
+		public:
+			static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+		public:
+			FrameArena() = default;
+
+			void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+			// the objects are not constructed and will never be destroyed
+			template <typename T>
+			inline T* allocate(std::size_t count)
+			{
+				static_assert(std::is_trivially_destructible_v<T>, "frame arena objects are never destroyed");
+				return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+			}
+
+			void reset() noexcept;
+			void destroy() noexcept;
+
+			inline std::size_t getUsedBytes() const noexcept { return _used; }
+			// chunks taken from the heap since the creation of the arena
+			inline std::uint64_t getHeapAllocations() const noexcept { return _heap_allocations; }
+
+			~FrameArena() = default;
+
+		private:
+			struct Chunk
+			{
+				std::unique_ptr<std::byte[]> data;
+				std::size_t size = 0;
+			};
+
+		private:
+			std::vector<Chunk> _chunks;
+			std::size_t _chunk = 0; // chunk being filled
+			std::size_t _offset = 0;
+			std::size_t _used = 0;
+			std::uint64_t _heap_allocations = 0;
+	};
+}
+
+#endif
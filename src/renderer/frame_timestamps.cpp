@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frame_timestamps.cpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:28:22 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:32:42 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#include <renderer/frame_timestamps.h>
+#include <renderer/command/vk_cmd_buffer.h>
+#include <core/profiler.h>
+#include <vector>
+
+namespace mlx
+{
+	void FrameTimestamps::init()
+	{
+		MLX_PROFILE_FUNCTION();
+		VkPhysicalDevice physical_device = Render_Core::get().getDevice().getPhysicalDevice();
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(physical_device, &props);
+
+		std::uint32_t count = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &count, nullptr);
+		std::vector<VkQueueFamilyProperties> families(count);
+		vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &count, families.data());
+		std::uint32_t valid_bits = families[Render_Core::get().getQueue().getFamilies().graphics_family.value()].timestampValidBits;
+		if(valid_bits == 0 || props.limits.timestampPeriod <= 0.0f)
+		{
+			#ifdef DEBUG
+				core::error::report(e_kind::message, "Vulkan : the graphics queue does not support timestamps, GPU times are disabled");
+			#endif
+			return;
+		}
+		_valid_mask = (valid_bits >= 64 ? UINT64_MAX : (std::uint64_t(1) << valid_bits) - 1);
+		_period = props.limits.timestampPeriod;
+
+		VkQueryPoolCreateInfo info{};
+		info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		info.queryCount = QUERIES_PER_FRAME * MAX_FRAMES_IN_FLIGHT;
+		VkResult res = vkCreateQueryPool(Render_Core::get().getDevice().get(), &info, nullptr, &_pool);
+		if(res != VK_SUCCESS)
+		{
+			core::error::report(e_kind::error, "Vulkan : failed to create the timestamps query pool, %s", RCore::verbaliseResultVk(res));
+			_pool = VK_NULL_HANDLE;
+		}
+	}
+
+	void FrameTimestamps::begin(CmdBuffer& cmd, std::uint32_t frame_index)
+	{
+		if(!isSupported())
+			return;
+		_frame_index = frame_index;
+		_frames[frame_index].written = 1;
+		_frames[frame_index].categories[0] = GPUTimeCategory::uploads;
+		_current = GPUTimeCategory::uploads;
+		_recording = true;
+		vkCmdResetQueryPool(cmd.get(), _pool, frame_index * QUERIES_PER_FRAME, QUERIES_PER_FRAME);
+		vkCmdWriteTimestamp(cmd.get(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, _pool, frame_index * QUERIES_PER_FRAME);
+	}
+
+	void FrameTimestamps::mark(CmdBuffer& cmd, GPUTimeCategory category)
+	{
+		if(!_recording || category == _current)
+			return;
+		Frame& frame = _frames[_frame_index];
+		if(frame.written == QUERIES_PER_FRAME - 1) // the last query is kept for the end of the frame
+			return;
+		vkCmdWriteTimestamp(cmd.get(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, _pool, _frame_index * QUERIES_PER_FRAME + frame.written);
+		frame.categories[frame.written] = category;
+		frame.written++;
+		_current = category;
+	}
+
+	void FrameTimestamps::end(CmdBuffer& cmd)
+	{
+		if(!_recording)
+			return;
+		Frame& frame = _frames[_frame_index];
+		vkCmdWriteTimestamp(cmd.get(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, _pool, _frame_index * QUERIES_PER_FRAME + frame.written);
+		frame.written++;
+		#ifdef PROFILER
+			frame.submit_time = Profiler::get().now();
+		#endif
+		_recording = false;
+	}
+
+	void FrameTimestamps::collect(std::uint32_t frame_index)
+	{
+		Frame& frame = _frames[frame_index];
+		if(!isSupported() || frame.written < 2)
+			return;
+		MLX_PROFILE_FUNCTION();
+		std::array<std::uint64_t, QUERIES_PER_FRAME> ticks;
+		// the frame fence has been waited on, results are expected to be there but it is never waited for them
+		VkResult res = vkGetQueryPoolResults(Render_Core::get().getDevice().get(), _pool, frame_index * QUERIES_PER_FRAME, frame.written, sizeof(std::uint64_t) * frame.written, ticks.data(), sizeof(std::uint64_t), VK_QUERY_RESULT_64_BIT);
+		std::uint32_t written = frame.written;
+		frame.written = 0;
+		if(res != VK_SUCCESS)
+			return;
+
+		_times.fill(0.0);
+		for(std::uint32_t i = 0; i + 1 < written; i++)
+		{
+			double ns = static_cast<double>((ticks[i + 1] - ticks[i]) & _valid_mask) * _period;
+			_times[static_cast<std::size_t>(frame.categories[i])] += ns / 1000000.0;
+			#ifdef PROFILER
+				static constexpr const char* names[] = { "GPU uploads", "GPU images", "GPU texts", "GPU pixel put", "GPU other" };
+				// GPU clocks are not related to CPU ones, the frame is laid out from the end of its recording
+				std::uint64_t begin = frame.submit_time + static_cast<std::uint64_t>(static_cast<double>((ticks[i] - ticks[0]) & _valid_mask) * _period);
+				Profiler::get().appendGPUEvent(names[static_cast<std::size_t>(frame.categories[i])], begin, begin + static_cast<std::uint64_t>(ns));
+			#endif
+		}
+		_frame_time = static_cast<double>((ticks[written - 1] - ticks[0]) & _valid_mask) * _period / 1000000.0;
+		_completed++;
+	}
+
+	void FrameTimestamps::destroy() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_pool != VK_NULL_HANDLE)
+			vkDestroyQueryPool(Render_Core::get().getDevice().get(), _pool, nullptr);
+		_pool = VK_NULL_HANDLE;
+		_recording = false;
+	}
+}
@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frame_timestamps.h                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:28:22 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:32:42 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#ifndef __MLX_FRAME_TIMESTAMPS__
+#define __MLX_FRAME_TIMESTAMPS__
+
+#include <mlx_profile.h>
+#include <volk.h>
+#include <array>
+#include <cstdint>
+#include <renderer/core/render_core.h>
+
+namespace mlx
+{
+	enum class GPUTimeCategory : std::uint8_t
+	{
+		uploads = 0,
+		images,
+		texts,
+		pixel_put,
+		other, // render pass clear, readbacks, ...
+		count
+	};
+
+	/**
+	 * Measures the GPU time of each frame and of its draw categories.
+	 * A timestamp is written in the frame command buffer each time the kind of
+	 * recorded work changes and the time between two timestamps goes to the
+	 * category that was active. Results are read once the fence of the frame
+	 * has been waited on, so reading them never stalls.
+	 * Frames switching category more often than the pool allows keep the last
+	 * category for the rest of the frame.
+	 */
+	class FrameTimestamps
+	{
+		public:
+			static constexpr std::uint32_t QUERIES_PER_FRAME = 64;
+
+		public:
+			FrameTimestamps() = default;
+
+			void init();
+			void begin(class CmdBuffer& cmd, std::uint32_t frame_index);
+			void mark(class CmdBuffer& cmd, GPUTimeCategory category);
+			void end(class CmdBuffer& cmd);
+			void collect(std::uint32_t frame_index);
+			void destroy() noexcept;
+
+			inline bool isSupported() const noexcept { return _pool != VK_NULL_HANDLE; }
+			// milliseconds of GPU time of the last completed frame, negative if timestamps are not supported
+			inline double getTime(GPUTimeCategory category) const noexcept { return isSupported() ? _times[static_cast<std::size_t>(category)] : -1.0; }
+			inline double getFrameTime() const noexcept { return isSupported() ? _frame_time : -1.0; }
+			inline std::uint64_t getCompletedFrames() const noexcept { return _completed; }
+
+			~FrameTimestamps() = default;
+
+		private:
+			struct Frame
+			{
+				std::array<GPUTimeCategory, QUERIES_PER_FRAME> categories; // category of the range starting at each query
+				std::uint64_t submit_time = 0; // CPU time of the recording end, used to place the GPU events in the profile
+				std::uint32_t written = 0;
+			};
+
+		private:
+			std::array<Frame, MAX_FRAMES_IN_FLIGHT> _frames;
+			std::array<double, static_cast<std::size_t>(GPUTimeCategory::count)> _times{};
+			VkQueryPool _pool = VK_NULL_HANDLE;
+			std::uint64_t _valid_mask = 0;
+			double _period = 1.0; // nanoseconds per tick
+			double _frame_time = 0.0;
+			std::uint64_t _completed = 0; // frames whose results have been read
+			std::uint32_t _frame_index = 0;
+			GPUTimeCategory _current = GPUTimeCategory::uploads;
+			bool _recording = false;
+	};
+}
+
+#endif
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   dirty_tiles.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 22:50:10 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:04:29 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <renderer/images/dirty_tiles.h>
+#include <core/profiler.h>
+#include <algorithm>
+#include <cstring>
+
+namespace mlx
+{
+	void DirtyTiles::init(std::uint32_t width, std::uint32_t height)
+	{
+		_width = width;
+		_height = height;
+		_tiles_x = (width + TILE_SIZE - 1) >> TILE_SHIFT;
+		_tiles_y = (height + TILE_SIZE - 1) >> TILE_SHIFT;
+		_tiles.assign(_tiles_x * _tiles_y, 0);
+		_is_dirty = false;
+	}
+
+	void DirtyTiles::markRegion(std::uint32_t x, std::uint32_t y, std::uint32_t w, std::uint32_t h) noexcept
+	{
+		if(w == 0 || h == 0)
+			return;
+		std::uint32_t tx_end = (x + w - 1) >> TILE_SHIFT;
+		std::uint32_t ty_end = (y + h - 1) >> TILE_SHIFT;
+		for(std::uint32_t ty = y >> TILE_SHIFT; ty <= ty_end; ty++)
+			std::fill(_tiles.begin() + ty * _tiles_x + (x >> TILE_SHIFT), _tiles.begin() + ty * _tiles_x + tx_end + 1, 1);
+		_is_dirty = true;
+	}
+
+	void DirtyTiles::markAll() noexcept
+	{
+		std::fill(_tiles.begin(), _tiles.end(), 1);
+		_is_dirty = true;
+	}
+
+	std::size_t DirtyTiles::getDirtySize(std::uint32_t pixel_size) const noexcept
+	{
+		if(!_is_dirty)
+			return 0;
+		std::size_t pixels = 0;
+		for(std::uint32_t ty = 0; ty < _tiles_y; ty++)
+		{
+			std::uint32_t h = std::min((ty + 1) << TILE_SHIFT, _height) - (ty << TILE_SHIFT);
+			for(std::uint32_t tx = 0; tx < _tiles_x; tx++)
+			{
+				if(_tiles[ty * _tiles_x + tx])
+					pixels += static_cast<std::size_t>(std::min((tx + 1) << TILE_SHIFT, _width) - (tx << TILE_SHIFT)) * h;
+			}
+		}
+		return pixels * pixel_size;
+	}
+
+	std::size_t DirtyTiles::flush(const void* src, void* dst, VkDeviceSize dst_offset, std::uint32_t pixel_size, std::vector<VkBufferImageCopy>& regions)
+	{
+		MLX_PROFILE_FUNCTION();
+		regions.clear();
+		if(!_is_dirty)
+			return 0;
+
+		std::size_t bytes = 0;
+		std::size_t row_pitch = static_cast<std::size_t>(_width) * pixel_size;
+		for(std::uint32_t ty = 0; ty < _tiles_y; ty++)
+		{
+			std::uint8_t* row = _tiles.data() + ty * _tiles_x;
+			for(std::uint32_t tx = 0; tx < _tiles_x;)
+			{
+				if(!row[tx])
+				{
+					tx++;
+					continue;
+				}
+				std::uint32_t run_begin = tx;
+				while(tx < _tiles_x && row[tx])
+					row[tx++] = 0;
+
+				std::uint32_t x = run_begin << TILE_SHIFT;
+				std::uint32_t y = ty << TILE_SHIFT;
+				std::uint32_t w = std::min(tx << TILE_SHIFT, _width) - x;
+				std::uint32_t h = std::min((ty + 1) << TILE_SHIFT, _height) - y;
+
+				std::size_t offset = y * row_pitch + static_cast<std::size_t>(x) * pixel_size;
+				std::size_t region_pitch = static_cast<std::size_t>(w) * pixel_size;
+				for(std::uint32_t j = 0; j < h; j++)
+					std::memcpy(static_cast<std::uint8_t*>(dst) + bytes + j * region_pitch, static_cast<const std::uint8_t*>(src) + offset + j * row_pitch, region_pitch);
+
+				VkBufferImageCopy region{};
+				region.bufferOffset = dst_offset + bytes;
+				region.bufferRowLength = 0; // tightly packed
+				region.bufferImageHeight = 0;
+				region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				region.imageSubresource.mipLevel = 0;
+				region.imageSubresource.baseArrayLayer = 0;
+				region.imageSubresource.layerCount = 1;
+				region.imageOffset = { static_cast<std::int32_t>(x), static_cast<std::int32_t>(y), 0 };
+				region.imageExtent = { w, h, 1 };
+				regions.push_back(region);
+				bytes += region_pitch * h;
+			}
+		}
+		_is_dirty = false;
+		return bytes;
+	}
+}
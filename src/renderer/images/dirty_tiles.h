@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   dirty_tiles.h                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 22:50:10 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:04:29 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_DIRTY_TILES__
+#define __MLX_DIRTY_TILES__
+
+#include <mlx_profile.h>
+#include <volk.h>
+#include <vector>
+#include <cstdint>
+
+namespace mlx
+{
+	/**
+	 * Keeps track of the parts of a CPU side image that have been written since
+	 * the last upload, using a grid of TILE_SIZE x TILE_SIZE tiles.
+	 * Dirty tiles are turned into buffer to image copy regions, merging
+	 * horizontally adjacent tiles of a same tile row into a single region.
+	 */
+	class DirtyTiles
+	{
+		public:
+			static constexpr std::uint32_t TILE_SHIFT = 5;
+			static constexpr std::uint32_t TILE_SIZE = 1 << TILE_SHIFT;
+
+		public:
+			DirtyTiles() = default;
+
+			void init(std::uint32_t width, std::uint32_t height);
+
+			// coordinates must be in bounds
+			inline void mark(std::uint32_t x, std::uint32_t y) noexcept
+			{
+				_tiles[(y >> TILE_SHIFT) * _tiles_x + (x >> TILE_SHIFT)] = 1;
+				_is_dirty = true;
+			}
+			void markRegion(std::uint32_t x, std::uint32_t y, std::uint32_t w, std::uint32_t h) noexcept;
+			void markAll() noexcept;
+
+			inline bool isDirty() const noexcept { return _is_dirty; }
+			std::size_t getDirtySize(std::uint32_t pixel_size) const noexcept; // bytes needed by the next flush
+
+			/**
+			 * Fills regions with the copy regions covering all dirty tiles, packs those
+			 * tiles of src (a tightly packed image of the tracked size) one region after
+			 * the other in dst and resets the tracking. The buffer offsets of the regions
+			 * start at dst_offset. Returns the number of bytes copied.
+			 */
+			std::size_t flush(const void* src, void* dst, VkDeviceSize dst_offset, std::uint32_t pixel_size, std::vector<VkBufferImageCopy>& regions);
+
+			~DirtyTiles() = default;
+
+		private:
+			std::vector<std::uint8_t> _tiles;
+			std::uint32_t _width = 0;
+			std::uint32_t _height = 0;
+			std::uint32_t _tiles_x = 0;
+			std::uint32_t _tiles_y = 0;
+			bool _is_dirty = false;
+	};
+}
+
+#endif
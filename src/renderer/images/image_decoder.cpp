@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   image_decoder.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:11:09 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:16:24 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <renderer/images/image_decoder.h>
+#include <core/errors.h>
+#include <core/profiler.h>
+#include <stb_image.h>
+#include <platform/mapped_file.h>
+#include <algorithm>
+#include <limits>
+
+namespace mlx
+{
+	void ImageDecoder::init()
+	{
+		MLX_PROFILE_FUNCTION();
+		if(isInit())
+			return;
+		_running = true;
+		unsigned int count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		for(unsigned int i = 0; i < count; i++)
+			_workers.emplace_back(&ImageDecoder::work, this);
+		#ifdef DEBUG
+			core::error::report(e_kind::message, "Image decoder : started %u workers", count);
+		#endif
+	}
+
+	void ImageDecoder::request(std::uint64_t id, std::string file)
+	{
+		MLX_PROFILE_FUNCTION();
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_requests.push_back(Request{ std::move(file), id });
+		}
+		_cv.notify_one();
+	}
+
+	void ImageDecoder::collect(std::vector<DecodedImage>& images)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		for(DecodedImage& image : _done)
+			images.push_back(std::move(image));
+		_done.clear();
+	}
+
+	void ImageDecoder::work()
+	{
+		for(;;)
+		{
+			Request request;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_cv.wait(lock, [this] { return !_running || !_requests.empty(); });
+				if(!_running)
+					return;
+				request = std::move(_requests.front());
+				_requests.pop_front();
+			}
+
+			DecodedImage image;
+			image.id = request.id;
+			MappedFile file;
+			if(!file.open(request.file))
+				core::error::report(e_kind::error, "Image : cannot read '%s'", request.file.c_str());
+			else if(file.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()) || stbi_is_hdr_from_memory(file.data(), static_cast<int>(file.size())))
+				core::error::report(e_kind::error, "Texture : unsupported image format '%s'", request.file.c_str());
+			else
+			{
+				int channels;
+				image.pixels = { stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &image.width, &image.height, &channels, 4), stbi_image_free };
+				if(!image.pixels)
+					core::error::report(e_kind::error, "Image : failed to decode '%s', %s", request.file.c_str(), stbi_failure_reason());
+			}
+
+			std::lock_guard<std::mutex> lock(_mutex);
+			_done.push_back(std::move(image));
+		}
+	}
+
+	void ImageDecoder::destroy() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_running = false;
+			_requests.clear();
+		}
+		_cv.notify_all();
+		for(std::thread& worker : _workers)
+			worker.join();
+		_workers.clear();
+		_done.clear();
+	}
+}
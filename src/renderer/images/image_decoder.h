@@ -0,0 +1,74 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   image_decoder.h                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:11:09 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:12:24 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_IMAGE_DECODER__
+#define __MLX_IMAGE_DECODER__
+
+#include <mlx_profile.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+
+namespace mlx
+{
+	struct DecodedImage
+	{
+		std::unique_ptr<std::uint8_t, void(*)(void*)> pixels = { nullptr, nullptr }; // RGBA8, null if the decoding failed
+		std::uint64_t id = 0;
+		int width = 0;
+		int height = 0;
+	};
+
+	/**
+	 * Pool of worker threads decoding image files with stb image.
+	 * Only the CPU side is done by the workers, finished images are collected
+	 * by the main thread which owns all GPU uploads.
+	 */
+	class ImageDecoder
+	{
+		public:
+			ImageDecoder() = default;
+
+			void init(); // starts one worker per hardware thread but the main one
+			void request(std::uint64_t id, std::string file);
+			void collect(std::vector<DecodedImage>& images); // moves the finished decodings to images, never blocks
+			inline bool isInit() const noexcept { return !_workers.empty(); }
+			void destroy() noexcept;
+
+			~ImageDecoder() = default;
+
+		private:
+			void work();
+
+		private:
+			struct Request
+			{
+				std::string file;
+				std::uint64_t id;
+			};
+
+		private:
+			std::deque<Request> _requests;
+			std::vector<DecodedImage> _done;
+			std::vector<std::thread> _workers;
+			std::mutex _mutex;
+			std::condition_variable _cv;
+			bool _running = false;
+	};
+}
+
+#endif
@@ -0,0 +1,58 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sampler_cache.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:01:26 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:03:41 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <renderer/images/sampler_cache.h>
+#include <renderer/core/render_core.h>
+#include <core/profiler.h>
+
+namespace mlx
+{
+	VkSampler SamplerCache::get(VkFilter filter, VkSamplerAddressMode address_mode)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::uint64_t key = (static_cast<std::uint64_t>(filter) << 32) | static_cast<std::uint64_t>(address_mode);
+		auto it = _samplers.find(key);
+		if(it != _samplers.end())
+			return it->second;
+
+		VkSamplerCreateInfo info{};
+		info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		info.magFilter = filter;
+		info.minFilter = filter;
+		info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		info.addressModeU = address_mode;
+		info.addressModeV = address_mode;
+		info.addressModeW = address_mode;
+		info.minLod = -1000;
+		info.maxLod = 1000;
+		info.anisotropyEnable = VK_FALSE;
+		info.maxAnisotropy = 1.0f;
+
+		VkSampler sampler = VK_NULL_HANDLE;
+		VkResult res = vkCreateSampler(Render_Core::get().getDevice().get(), &info, nullptr, &sampler);
+		if(res != VK_SUCCESS)
+			core::error::report(e_kind::fatal_error, "Vulkan : failed to create an image sampler, %s", RCore::verbaliseResultVk(res));
+		#ifdef DEBUG
+			Render_Core::get().getLayers().setDebugUtilsObjectNameEXT(VK_OBJECT_TYPE_SAMPLER, (std::uint64_t)sampler, "__mlx_shared_sampler");
+			core::error::report(e_kind::message, "Vulkan : created new shared image sampler");
+		#endif
+		_samplers[key] = sampler;
+		return sampler;
+	}
+
+	void SamplerCache::destroy() noexcept
+	{
+		for(auto& [key, sampler] : _samplers)
+			vkDestroySampler(Render_Core::get().getDevice().get(), sampler, nullptr);
+		_samplers.clear();
+	}
+}
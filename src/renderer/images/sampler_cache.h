@@ -1,31 +1,38 @@
 /* ************************************************************************** */
 /*                                                                            */
 /*                                                        :::      ::::::::   */
-/*   drawable_resource.h                                :+:      :+:    :+:   */
+/*   sampler_cache.h                                    :+:      :+:    :+:   */
 /*                                                    +:+ +:+         +:+     */
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
-/*   Created: 2024/01/10 21:00:37 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/11 01:21:15 by maldavid         ###   ########.fr       */
+/*   Created: 2026/10/16 23:01:26 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:03:41 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
-#ifndef __MLX_DRAWABLE_RESOURCE__
-#define __MLX_DRAWABLE_RESOURCE__
+#ifndef __MLX_SAMPLER_CACHE__
+#define __MLX_SAMPLER_CACHE__
 
 #include <mlx_profile.h>
 #include <volk.h>
-#include <array>
+#include <unordered_map>
+#include <cstdint>
 
 namespace mlx
 {
-	class DrawableResource
+	// Samplers only depend on their parameters, images share them instead of creating their own
+	class SamplerCache
 	{
 		public:
-			DrawableResource() = default;
-			virtual void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer) = 0;
-			virtual void resetUpdate() {}
-			virtual ~DrawableResource() = default;
+			SamplerCache() = default;
+
+			VkSampler get(VkFilter filter, VkSamplerAddressMode address_mode);
+			void destroy() noexcept;
+
+			~SamplerCache() = default;
+
+		private:
+			std::unordered_map<std::uint64_t, VkSampler> _samplers;
 	};
 }
 
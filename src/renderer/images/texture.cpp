@@ -6,16 +6,20 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/03/31 18:03:35 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 19:07:01 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:36:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <core/errors.h>
 #include <renderer/images/texture.h>
 #include <renderer/buffers/vk_buffer.h>
+#include <renderer/buffers/staging_ring.h>
 #include <renderer/renderer.h>
 #include <core/profiler.h>
 #include <cstring>
+#include <algorithm>
+#include <limits>
+#include <platform/mapped_file.h>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -36,64 +40,62 @@ namespace mlx
 		Image::createSampler();
 		transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
-		std::vector<Vertex> vertexData = {
-			{{0, 0},			{1.f, 1.f, 1.f, 1.f},	{0.0f, 0.0f}},
-			{{width, 0},		{1.f, 1.f, 1.f, 1.f},	{1.0f, 0.0f}},
-			{{width, height},	{1.f, 1.f, 1.f, 1.f},	{1.0f, 1.0f}},
-			{{0, height},		{1.f, 1.f, 1.f, 1.f},	{0.0f, 1.0f}}
-		};
+		#ifdef DEBUG
+			_name = name;
+		#endif
+
+		Image::uploadPixels(pixels);
+	}
+
+	void Texture::createCopy(Texture& source, const char* name)
+	{
+		MLX_PROFILE_FUNCTION();
+		source.openCPUmap(); // kept by the source, later copies do not read it back again
+		create(reinterpret_cast<std::uint8_t*>(source._cpu_map.data()), source.getWidth(), source.getHeight(), source.getFormat(), name);
+		// copies are made to be written, the CPU map is opened right away
+		_cpu_map = source._cpu_map;
+		_dirty_tiles.init(getWidth(), getHeight());
+	}
 
-		std::vector<std::uint16_t> indexData = { 0, 1, 2, 2, 3, 0 };
+	void Texture::createFromBuffer(Buffer& buffer, VkDeviceSize offset, std::uint32_t width, std::uint32_t height, VkFormat format, const char* name, CmdBuffer& cmd)
+	{
+		MLX_PROFILE_FUNCTION();
+		Image::create(width, height, format, TILING, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, name);
+		Image::createImageView(VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT);
+		Image::createSampler();
+		transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, &cmd);
 
 		#ifdef DEBUG
-			_vbo.create(sizeof(Vertex) * vertexData.size(), vertexData.data(), name);
-			_ibo.create(sizeof(std::uint16_t) * indexData.size(), indexData.data(), name);
 			_name = name;
-		#else
-			_vbo.create(sizeof(Vertex) * vertexData.size(), vertexData.data(), nullptr);
-			_ibo.create(sizeof(std::uint16_t) * indexData.size(), indexData.data(), nullptr);
 		#endif
 
-		Buffer staging_buffer;
-		std::size_t size = width * height * formatSize(format);
-		if(pixels != nullptr)
-		{
-			#ifdef DEBUG
-				staging_buffer.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, name, pixels);
-			#else
-				staging_buffer.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, nullptr, pixels);
-			#endif
-		}
-		else
-		{
-			std::vector<std::uint32_t> default_pixels(width * height, 0x00000000);
-			#ifdef DEBUG
-				staging_buffer.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, name, default_pixels.data());
-			#else
-				staging_buffer.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, nullptr, default_pixels.data());
-			#endif
-		}
-		Image::copyFromBuffer(staging_buffer);
-		staging_buffer.destroy();
+		VkBufferImageCopy region{};
+		region.bufferOffset = offset;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.layerCount = 1;
+		region.imageExtent = { width, height, 1 };
+		_upload_regions.assign(1, region);
+		Image::copyFromBuffer(buffer, _upload_regions, &cmd);
+		_upload_regions.clear();
 	}
 
 	void Texture::setPixel(int x, int y, std::uint32_t color) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		if(x < 0 || y < 0 || static_cast<std::uint32_t>(x) > getWidth() || static_cast<std::uint32_t>(y) > getHeight())
+		if(x < 0 || y < 0 || static_cast<std::uint32_t>(x) >= getWidth() || static_cast<std::uint32_t>(y) >= getHeight())
 			return;
-		if(_map == nullptr)
+		if(_cpu_map.empty())
 			openCPUmap();
 		_cpu_map[(y * getWidth()) + x] = color;
-		_has_been_modified = true;
+		_dirty_tiles.mark(x, y);
 	}
 
 	int Texture::getPixel(int x, int y) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		if(x < 0 || y < 0 || static_cast<std::uint32_t>(x) > getWidth() || static_cast<std::uint32_t>(y) > getHeight())
+		if(x < 0 || y < 0 || static_cast<std::uint32_t>(x) >= getWidth() || static_cast<std::uint32_t>(y) >= getHeight())
 			return 0;
-		if(_map == nullptr)
+		if(_cpu_map.empty())
 			openCPUmap();
 		std::uint32_t color = _cpu_map[(y * getWidth()) + x];
 		std::uint8_t* bytes = reinterpret_cast<std::uint8_t*>(&color);
@@ -103,88 +105,178 @@ namespace mlx
 		return *reinterpret_cast<int*>(bytes);
 	}
 
+	static inline std::uint32_t swapRedBlue(std::uint32_t color) noexcept
+	{
+		return (color & 0xFF00FF00) | ((color & 0x00FF0000) >> 16) | ((color & 0x000000FF) << 16);
+	}
+
+	void Texture::setRegion(int x, int y, int w, int h, const std::uint32_t* pixels) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		int x_begin = std::max(x, 0);
+		int y_begin = std::max(y, 0);
+		int x_end = std::min(x + w, static_cast<int>(getWidth()));
+		int y_end = std::min(y + h, static_cast<int>(getHeight()));
+		if(x_begin >= x_end || y_begin >= y_end)
+			return;
+		if(_cpu_map.empty())
+			openCPUmap();
+		for(int j = y_begin; j < y_end; j++)
+		{
+			const std::uint32_t* src = pixels + (j - y) * w + (x_begin - x);
+			std::uint32_t* dst = _cpu_map.data() + j * getWidth() + x_begin;
+			for(int i = 0; i < x_end - x_begin; i++)
+				dst[i] = swapRedBlue(src[i]);
+		}
+		_dirty_tiles.markRegion(x_begin, y_begin, x_end - x_begin, y_end - y_begin);
+	}
+
+	void Texture::getRegion(int x, int y, int w, int h, std::uint32_t* pixels) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		int x_begin = std::max(x, 0);
+		int y_begin = std::max(y, 0);
+		int x_end = std::min(x + w, static_cast<int>(getWidth()));
+		int y_end = std::min(y + h, static_cast<int>(getHeight()));
+		if(x_begin >= x_end || y_begin >= y_end)
+			return;
+		if(_cpu_map.empty())
+			openCPUmap();
+		for(int j = y_begin; j < y_end; j++)
+		{
+			const std::uint32_t* src = _cpu_map.data() + j * getWidth() + x_begin;
+			std::uint32_t* dst = pixels + (j - y) * w + (x_begin - x);
+			for(int i = 0; i < x_end - x_begin; i++)
+				dst[i] = swapRedBlue(src[i]);
+		}
+	}
+
 	void Texture::openCPUmap()
 	{
 		MLX_PROFILE_FUNCTION();
-		if(_map != nullptr)
+		if(!_cpu_map.empty())
 			return;
 
 		#ifdef DEBUG
 			core::error::report(e_kind::message, "Texture : enabling CPU mapping");
 		#endif
 		std::size_t size = getWidth() * getHeight() * formatSize(getFormat());
-		_buf_map.emplace();
+		// only needed to read the current content, the uploads go through the staging ring
+		Buffer readback;
 		#ifdef DEBUG
-			_buf_map->create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, _name.c_str());
+			readback.create(Buffer::kind::readback, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, _name.c_str());
 		#else
-			_buf_map->create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, nullptr);
+			readback.create(Buffer::kind::readback, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, nullptr);
 		#endif
-		Image::copyToBuffer(*_buf_map);
-		_buf_map->mapMem(&_map);
+		Image::copyToBuffer(readback);
+		void* map = nullptr;
+		readback.mapMem(&map);
+		readback.invalidate();
 		_cpu_map = std::vector<std::uint32_t>(getWidth() * getHeight(), 0);
-		std::memcpy(_cpu_map.data(), _map, size);
+		std::memcpy(_cpu_map.data(), map, size);
+		readback.destroy();
+		_dirty_tiles.init(getWidth(), getHeight());
 		#ifdef DEBUG
-			core::error::report(e_kind::message, "Texture : mapped CPU memory using staging buffer");
+			core::error::report(e_kind::message, "Texture : copied the texture to CPU memory");
 		#endif
 	}
 
-	void Texture::render(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer, int x, int y)
+	void Texture::update(Renderer& renderer)
 	{
 		MLX_PROFILE_FUNCTION();
-		if(_has_been_modified)
+		CmdBuffer& cmd = renderer.getActiveCmdBuffer();
+		if(_dirty_tiles.isDirty())
 		{
-			std::memcpy(_map, _cpu_map.data(), _cpu_map.size() * formatSize(getFormat()));
-			Image::copyFromBuffer(*_buf_map);
-			_has_been_modified = false;
+			// staged apart for each frame, the copies of the frames in flight may still be reading theirs
+			std::uint32_t pixel_size = formatSize(getFormat());
+			StagingRing& ring = StagingRing::get();
+			StagingRing::Allocation staging = ring.allocate(_dirty_tiles.getDirtySize(pixel_size), StagingRing::DEFAULT_ALIGNMENT, &cmd);
+			renderer.getFrameCounters().uploaded_bytes += _dirty_tiles.flush(_cpu_map.data(), staging.data, staging.offset, pixel_size, _upload_regions);
+			ring.flush(staging);
+			Image::copyFromBuffer(*staging.buffer, _upload_regions, &cmd);
 		}
+		if(getLayout() != VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+			transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, &cmd);
+	}
+
+	VkDescriptorSet Texture::prepareSet(Renderer& renderer)
+	{
 		if(!_set.isInit())
 			_set = renderer.getFragDescriptorSet().duplicate();
 		if(getLayout() != VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
 			transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 		if(!_has_set_been_updated)
 			updateSet(0);
-		auto cmd = renderer.getActiveCmdBuffer();
-		_vbo.bind(renderer);
-		_ibo.bind(renderer);
-		glm::vec2 translate(x, y);
-		vkCmdPushConstants(cmd.get(), renderer.getPipeline().getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(translate), &translate);
-		sets[1] = _set.get();
-		vkCmdBindDescriptorSets(renderer.getActiveCmdBuffer().get(), VK_PIPELINE_BIND_POINT_GRAPHICS, renderer.getPipeline().getPipelineLayout(), 0, sets.size(), sets.data(), 0, nullptr);
-		vkCmdDrawIndexed(cmd.get(), static_cast<std::uint32_t>(_ibo.getSize() / sizeof(std::uint16_t)), 1, 0, 0, 0);
+		return _set.get();
+	}
+
+	std::uint32_t Texture::prepareTableIndex()
+	{
+		if(getLayout() != VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+			transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		if(_table_index == TextureTable::INVALID_INDEX)
+			_table_index = Render_Core::get().getTextureTable().add(*this);
+		return _table_index;
 	}
 
 	void Texture::destroy() noexcept
 	{
 		MLX_PROFILE_FUNCTION();
+		Render_Core::get().getTextureTable().remove(_table_index);
+		_table_index = TextureTable::INVALID_INDEX;
 		Image::destroy();
 		_set.destroy();
-		if(_buf_map.has_value())
-			_buf_map->destroy();
-		_vbo.destroy();
-		_ibo.destroy();
+		_cpu_map.clear();
 	}
 
 	Texture stbTextureLoad(std::filesystem::path file, int* w, int* h)
 	{
 		MLX_PROFILE_FUNCTION();
-		Texture texture;
-		int channels;
-		std::uint8_t* data = nullptr;
 		std::string filename = file.string();
-
-		if(!std::filesystem::exists(std::move(file)))
+		if(!std::filesystem::exists(file))
 			core::error::report(e_kind::fatal_error, "Image : file not found '%s'", filename.c_str());
-		if(stbi_is_hdr(filename.c_str()))
-			core::error::report(e_kind::fatal_error, "Texture : unsupported image format '%s'", filename.c_str());
-		int dummy_w;
-		int dummy_h;
-		data = stbi_load(filename.c_str(), (w == nullptr ? &dummy_w : w), (h == nullptr ? &dummy_h : h), &channels, 4);
+		MappedFile mapped;
+		if(!mapped.open(file))
+		{
+			core::error::report(e_kind::error, "Image : cannot read '%s'", filename.c_str());
+			return Texture{};
+		}
+		return stbTextureLoadFromMemory(mapped.data(), mapped.size(), w, h, filename.c_str());
+	}
+
+	Texture stbTextureLoadFromMemory(const std::uint8_t* data, std::size_t size, int* w, int* h, const char* name)
+	{
+		MLX_PROFILE_FUNCTION();
+		Texture texture;
+		if(size > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+		{
+			core::error::report(e_kind::error, "Texture : image data too large '%s'", name);
+			return texture;
+		}
+		if(stbi_is_hdr_from_memory(data, static_cast<int>(size)))
+		{
+			core::error::report(e_kind::error, "Texture : unsupported image format '%s'", name);
+			return texture;
+		}
+		int width;
+		int height;
+		int channels;
+		std::uint8_t* pixels = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels, 4);
+		if(pixels == nullptr)
+		{
+			core::error::report(e_kind::error, "Texture : failed to decode '%s', %s", name, stbi_failure_reason());
+			return texture;
+		}
+		if(w != nullptr)
+			*w = width;
+		if(h != nullptr)
+			*h = height;
 		#ifdef DEBUG
-			texture.create(data, (w == nullptr ? dummy_w : *w), (h == nullptr ? dummy_h : *h), VK_FORMAT_R8G8B8A8_UNORM, filename.c_str());
+			texture.create(pixels, width, height, VK_FORMAT_R8G8B8A8_UNORM, name);
 		#else
-			texture.create(data, (w == nullptr ? dummy_w : *w), (h == nullptr ? dummy_h : *h), VK_FORMAT_R8G8B8A8_UNORM, nullptr);
+			texture.create(pixels, width, height, VK_FORMAT_R8G8B8A8_UNORM, nullptr);
 		#endif
-		stbi_image_free(data);
+		stbi_image_free(pixels);
 		return texture;
 	}
 }
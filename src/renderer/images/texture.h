@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/03/08 02:24:58 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 19:06:07 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:36:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,9 +16,10 @@
 #include <filesystem>
 #include <array>
 #include <renderer/images/vk_image.h>
+#include <renderer/images/dirty_tiles.h>
 #include <renderer/descriptors/vk_descriptor_set.h>
-#include <renderer/buffers/vk_ibo.h>
-#include <renderer/buffers/vk_vbo.h>
+#include <renderer/descriptors/texture_table.h>
+#include <renderer/buffers/vk_buffer.h>
 #include <mlx_profile.h>
 #ifdef DEBUG
 	#include <string>
@@ -32,17 +33,24 @@ namespace mlx
 			Texture() = default;
 
 			void create(std::uint8_t* pixels, std::uint32_t width, std::uint32_t height, VkFormat format, const char* name, bool dedicated_memory = false);
-			void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer, int x, int y);
+			void createCopy(Texture& source, const char* name); // source must not have pending writes
+			void createFromBuffer(Buffer& buffer, VkDeviceSize offset, std::uint32_t width, std::uint32_t height, VkFormat format, const char* name, CmdBuffer& cmd); // records the upload in cmd, buffer must outlive its submission
+			void update(class Renderer& renderer);
+			VkDescriptorSet prepareSet(class Renderer& renderer); // makes the descriptor set ready to be bound in the current frame
+			std::uint32_t prepareTableIndex(); // same for the texture table, returns TextureTable::INVALID_INDEX if it is full
 			void destroy() noexcept override;
 
 			void setPixel(int x, int y, std::uint32_t color) noexcept;
 			int getPixel(int x, int y) noexcept;
 
+			// regions are tightly packed rows of 0xAARRGGBB pixels, clipped to the texture bounds
+			void setRegion(int x, int y, int w, int h, const std::uint32_t* pixels) noexcept;
+			void getRegion(int x, int y, int w, int h, std::uint32_t* pixels) noexcept;
+
 			inline void setDescriptor(DescriptorSet&& set) noexcept { _set = set; }
 			inline VkDescriptorSet getSet() noexcept { return _set.isInit() ? _set.get() : VK_NULL_HANDLE; }
 			inline void updateSet(int binding) noexcept { _set.writeDescriptor(binding, *this); _has_set_been_updated = true; }
 			inline bool hasBeenUpdated() const noexcept { return _has_set_been_updated; }
-			inline constexpr void resetUpdate() noexcept { _has_set_been_updated = false; }
 
 			~Texture() = default;
 
@@ -50,20 +58,19 @@ namespace mlx
 			void openCPUmap();
 
 		private:
-			C_VBO _vbo;
-			C_IBO _ibo;
 			#ifdef DEBUG
 				std::string _name;
 			#endif
 			DescriptorSet _set;
-			std::vector<std::uint32_t> _cpu_map;
-			std::optional<Buffer> _buf_map = std::nullopt;
-			void* _map = nullptr;
-			bool _has_been_modified = false;
+			std::vector<std::uint32_t> _cpu_map; // empty until the first CPU access
+			std::vector<VkBufferImageCopy> _upload_regions;
+			DirtyTiles _dirty_tiles;
+			std::uint32_t _table_index = TextureTable::INVALID_INDEX;
 			bool _has_set_been_updated = false;
 	};
 
 	Texture stbTextureLoad(std::filesystem::path file, int* w, int* h);
+	Texture stbTextureLoadFromMemory(const std::uint8_t* data, std::size_t size, int* w, int* h, const char* name); // the texture is not initialized if the decoding failed
 }
 
 #endif
@@ -6,11 +6,12 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/07 16:40:09 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/18 10:18:08 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:50:50 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <renderer/images/texture_atlas.h>
+#include <renderer/renderer.h>
 
 #ifdef IMAGE_OPTIMIZED
 	#define TILING VK_IMAGE_TILING_OPTIMAL
@@ -32,11 +33,7 @@ namespace mlx
 			core::error::report(e_kind::warning, "Renderer : creating an empty texture atlas. They cannot be updated after creation, this might be a mistake or a bug, please report");
 			return;
 		}
-		Buffer staging_buffer;
-		std::size_t size = width * height * formatSize(format);
-		staging_buffer.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, name, pixels);
-		Image::copyFromBuffer(staging_buffer);
-		staging_buffer.destroy();
+		Image::uploadPixels(pixels);
 	}
 
 	void TextureAtlas::render(Renderer& renderer, int x, int y, std::uint32_t ibo_size) const
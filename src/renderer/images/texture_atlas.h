@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/07 16:36:33 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 19:57:55 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:03:41 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -33,7 +33,6 @@ namespace mlx
 			inline DescriptorSet getSet() noexcept { return _set; }
 			inline void updateSet(int binding) noexcept { _set.writeDescriptor(binding, *this); _has_been_updated = true; }
 			inline bool hasBeenUpdated() const noexcept { return _has_been_updated; }
-			inline constexpr void resetUpdate() noexcept { _has_been_updated = false; }
 
 			~TextureAtlas() = default;
 
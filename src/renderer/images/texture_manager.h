@@ -6,17 +6,19 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/11 00:56:15 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 13:53:59 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef __MLX_TEXTURE_MANAGER__
 #define __MLX_TEXTURE_MANAGER__
 
-#include <unordered_set>
-#include <renderer/images/texture_descriptor.h>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <renderer/images/texture.h>
+#include <utils/pool_allocator.h>
 #include <core/profiler.h>
-#include <utility>
 
 namespace mlx
 {
@@ -25,42 +27,67 @@ namespace mlx
 		public:
 			TextureManager() = default;
 
-			inline void clear() { _texture_descriptors.clear(); }
+			inline void clear() { _textures.clear(); _indices.clear(); _free_indices.clear(); }
 
-			inline std::pair<DrawableResource*, bool> registerTexture(Texture* texture, int x, int y)
+			inline std::uint32_t registerTexture(Texture* texture)
 			{
 				MLX_PROFILE_FUNCTION();
-				auto res = _texture_descriptors.emplace(texture, x, y);
-				return std::make_pair(static_cast<DrawableResource*>(&const_cast<TextureRenderDescriptor&>(*res.first)), res.second);
+				auto res = _indices.try_emplace(texture, 0);
+				if(!res.second)
+					return res.first->second;
+				if(!_free_indices.empty())
+				{
+					res.first->second = _free_indices.back();
+					_free_indices.pop_back();
+					_textures[res.first->second] = texture;
+				}
+				else
+				{
+					res.first->second = static_cast<std::uint32_t>(_textures.size());
+					_textures.push_back(texture);
+				}
+				return res.first->second;
+			}
+
+			inline Texture* getTexture(std::uint32_t index) const noexcept { return _textures[index]; }
+
+			inline bool getIndex(Texture* texture, std::uint32_t& index) const noexcept
+			{
+				auto it = _indices.find(texture);
+				if(it == _indices.end())
+					return false;
+				index = it->second;
+				return true;
 			}
 
-			inline bool isTextureKnown(Texture* texture) noexcept
+			inline void eraseTexture(Texture* texture)
 			{
 				MLX_PROFILE_FUNCTION();
-				for(const auto& desc : _texture_descriptors)
-				{
-					if(desc.texture == texture)
-						return true;
-				}
-				return false;
+				auto it = _indices.find(texture);
+				if(it == _indices.end())
+					return;
+				_textures[it->second] = nullptr;
+				_free_indices.push_back(it->second);
+				_indices.erase(it);
 			}
 
-			inline void eraseTextures(Texture* texture)
+			// records the uploads of every texture used this frame, once per texture
+			inline void update(class Renderer& renderer)
 			{
 				MLX_PROFILE_FUNCTION();
-				for(auto it = _texture_descriptors.begin(); it != _texture_descriptors.end();)
+				for(Texture* texture : _textures)
 				{
-					if(it->texture == texture)
-						it = _texture_descriptors.erase(it);
-					else
-						++it;
+					if(texture != nullptr && texture->isInit())
+						texture->update(renderer);
 				}
 			}
 
 			~TextureManager() = default;
 
 		private:
-			std::unordered_set<TextureRenderDescriptor> _texture_descriptors;
+			std::unordered_map<Texture*, std::uint32_t, std::hash<Texture*>, std::equal_to<Texture*>, PoolAllocator<std::pair<Texture* const, std::uint32_t>>> _indices;
+			std::vector<Texture*> _textures;
+			std::vector<std::uint32_t> _free_indices;
 	};
 }
 
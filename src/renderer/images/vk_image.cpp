@@ -6,15 +6,17 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/01/25 11:59:07 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:28:25 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:50:50 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "vk_image.h"
 #include <renderer/core/render_core.h>
 #include <renderer/buffers/vk_buffer.h>
+#include <renderer/buffers/staging_ring.h>
 #include <renderer/command/vk_cmd_pool.h>
 #include <renderer/core/vk_fence.h>
+#include <cstring>
 
 namespace mlx
 {
@@ -159,26 +161,7 @@ namespace mlx
 
 	void Image::createSampler() noexcept
 	{
-		VkSamplerCreateInfo info{};
-		info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-		info.magFilter = VK_FILTER_NEAREST;
-		info.minFilter = VK_FILTER_NEAREST;
-		info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
-		info.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-		info.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-		info.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-		info.minLod = -1000;
-		info.maxLod = 1000;
-		info.anisotropyEnable = VK_FALSE;
-		info.maxAnisotropy = 1.0f;
-
-		VkResult res = vkCreateSampler(Render_Core::get().getDevice().get(), &info, nullptr, &_sampler);
-		if(res != VK_SUCCESS)
-			core::error::report(e_kind::fatal_error, "Vulkan : failed to create an image sampler, %s", RCore::verbaliseResultVk(res));
-		#ifdef DEBUG
-		else
-			Render_Core::get().getLayers().setDebugUtilsObjectNameEXT(VK_OBJECT_TYPE_SAMPLER, (std::uint64_t)_sampler, _name.c_str());
-		#endif
+		_sampler = Render_Core::get().getSamplerCache().get(VK_FILTER_NEAREST, VK_SAMPLER_ADDRESS_MODE_REPEAT);
 	}
 
 	void Image::copyFromBuffer(Buffer& buffer)
@@ -197,6 +180,62 @@ namespace mlx
 		cmd.submitIdle();
 	}
 
+	void Image::copyFromBuffer(Buffer& buffer, const std::vector<VkBufferImageCopy>& regions, CmdBuffer* cmd)
+	{
+		if(regions.empty())
+			return;
+
+		bool singleTime = (cmd == nullptr);
+		if(singleTime)
+		{
+			cmd = &Render_Core::get().getSingleTimeCmdBuffer();
+			cmd->beginRecord();
+		}
+
+		VkImageLayout layout_save = _layout;
+		transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, cmd);
+
+		cmd->copyBufferToImage(buffer, *this, regions);
+
+		transitionLayout(layout_save, cmd);
+
+		if(singleTime)
+		{
+			cmd->endRecord();
+			cmd->submitIdle();
+		}
+	}
+
+	void Image::uploadPixels(const void* pixels)
+	{
+		StagingRing& ring = StagingRing::get();
+		VkDeviceSize size = static_cast<VkDeviceSize>(_width) * _height * formatSize(_format);
+		StagingRing::Allocation staging;
+		if(pixels != nullptr)
+			staging = ring.upload(pixels, size);
+		else
+		{
+			// cleared in place instead of copying a zeroed image from the heap
+			staging = ring.allocate(size);
+			std::memset(staging.data, 0, size);
+			ring.flush(staging);
+		}
+
+		VkBufferImageCopy region{};
+		region.bufferOffset = staging.offset;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.layerCount = 1;
+		region.imageExtent = { _width, _height, 1 };
+
+		CmdBuffer& cmd = Render_Core::get().getSingleTimeCmdBuffer();
+		cmd.beginRecord();
+		copyFromBuffer(*staging.buffer, { region }, &cmd);
+		cmd.endRecord();
+		cmd.submitIdle();
+
+		ring.release(cmd.getSubmissionSerial());
+	}
+
 	void Image::copyToBuffer(Buffer& buffer)
 	{
 		CmdBuffer& cmd = Render_Core::get().getSingleTimeCmdBuffer();
@@ -235,23 +274,21 @@ namespace mlx
 		_layout = new_layout;
 	}
 
-	void Image::destroySampler() noexcept
-	{
-		if(_sampler != VK_NULL_HANDLE)
-			vkDestroySampler(Render_Core::get().getDevice().get(), _sampler, nullptr);
-		_sampler = VK_NULL_HANDLE;
-	}
-
 	void Image::destroyImageView() noexcept
 	{
 		if(_image_view != VK_NULL_HANDLE)
-			vkDestroyImageView(Render_Core::get().getDevice().get(), _image_view, nullptr);
+		{
+			Render_Core::get().getDeletionQueue().push([image_view = _image_view]()
+			{
+				vkDestroyImageView(Render_Core::get().getDevice().get(), image_view, nullptr);
+			});
+		}
 		_image_view = VK_NULL_HANDLE;
 	}
 
 	void Image::destroy() noexcept
 	{
-		destroySampler();
+		_sampler = VK_NULL_HANDLE; // samplers are owned by the sampler cache
 		destroyImageView();
 
 		if(_image != VK_NULL_HANDLE)
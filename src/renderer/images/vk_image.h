@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/01/25 11:54:21 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/19 06:10:15 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:50:50 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -19,6 +19,7 @@
 #include <renderer/core/cmd_resource.h>
 #include <renderer/command/vk_cmd_buffer.h>
 #include <renderer/command/vk_cmd_pool.h>
+#include <vector>
 
 #ifdef DEBUG
 	#include <string>
@@ -51,6 +52,8 @@ namespace mlx
 			void createImageView(VkImageViewType type, VkImageAspectFlags aspectFlags) noexcept;
 			void createSampler() noexcept;
 			void copyFromBuffer(class Buffer& buffer);
+			void copyFromBuffer(class Buffer& buffer, const std::vector<VkBufferImageCopy>& regions, CmdBuffer* cmd = nullptr);
+			void uploadPixels(const void* pixels); // goes through the staging ring, null pixels clear the image
 			void copyToBuffer(class Buffer& buffer);
 			void transitionLayout(VkImageLayout new_layout, CmdBuffer* cmd = nullptr);
 			virtual void destroy() noexcept;
@@ -69,7 +72,6 @@ namespace mlx
 			virtual ~Image() = default;
 
 		private:
-			void destroySampler() noexcept;
 			void destroyImageView() noexcept;
 
 		private:
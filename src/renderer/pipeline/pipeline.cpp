@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/12/18 21:27:38 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:05:21 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:34:21 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,6 +14,7 @@
 #include <renderer/renderer.h>
 #include <renderer/core/render_core.h>
 #include <renderer/descriptors/vk_descriptor_set_layout.h>
+#include <core/profiler.h>
 
 namespace mlx
 {
@@ -160,24 +161,218 @@ namespace mlx
 		0x000100fd,0x00010038
 	};
 
-	void GraphicPipeline::init(Renderer& renderer)
-    {
-		VkShaderModuleCreateInfo createInfo{};
-		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-		createInfo.codeSize = vertex_shader.size() * sizeof(std::uint32_t);
-		createInfo.pCode = vertex_shader.data();
-		VkShaderModule vshader;
-		if(vkCreateShaderModule(Render_Core::get().getDevice().get(), &createInfo, nullptr, &vshader) != VK_SUCCESS)
-			core::error::report(e_kind::fatal_error, "Vulkan : failed to create a vertex shader module");
+	/**
+			#version 450 core
+			#extension GL_EXT_nonuniform_qualifier : require
+
+			layout(location = 0) out vec4 fColor;
+
+			layout(set = 1, binding = 0) uniform sampler2D sTextures[];
+
+			layout(push_constant) uniform uTexturePushConstant {
+				uint index;
+			} uTexture;
+
+			layout(location = 0) in struct {
+				vec4 Color;
+				vec2 UV;
+			} In;
+
+			void main()
+			{
+				vec4 process_color = In.Color * texture(sTextures[nonuniformEXT(uTexture.index)], In.UV.st);
+				if(process_color.w == 0)
+					discard;
+				fColor = process_color;
+			}
+	*/
+	const std::vector<std::uint32_t> bindless_fragment_shader = {	// precompiled fragment shader sampling the texture table
+		0x07230203,0x00010000,0x0008000b,0x00000034,0x00000000,0x00020011,0x00000001,0x00020011,
+		0x000014b5,0x00020011,0x000014b6,0x00020011,0x000014bb,0x0008000a,0x5f565053,0x5f545845,
+		0x63736564,0x74706972,0x695f726f,0x7865646e,0x00676e69,0x0006000b,0x00000001,0x4c534c47,
+		0x6474732e,0x3035342e,0x00000000,0x0003000e,0x00000000,0x00000001,0x0007000f,0x00000004,
+		0x00000002,0x6e69616d,0x00000000,0x00000003,0x00000004,0x00030010,0x00000002,0x00000007,
+		0x00030003,0x00000002,0x000001c2,0x00040005,0x00000002,0x6e69616d,0x00000000,0x00060005,
+		0x00000005,0x636f7270,0x5f737365,0x6f6c6f63,0x00000072,0x00030005,0x00000006,0x00000000,
+		0x00050006,0x00000006,0x00000000,0x6f6c6f43,0x00000072,0x00040006,0x00000006,0x00000001,
+		0x00005655,0x00030005,0x00000003,0x00006e49,0x00050005,0x00000007,0x78655473,0x65727574,
+		0x00000073,0x00080005,0x00000008,0x78655475,0x65727574,0x68737550,0x736e6f43,0x746e6174,
+		0x00000000,0x00050006,0x00000008,0x00000000,0x65646e69,0x00000078,0x00050005,0x00000009,
+		0x78655475,0x65727574,0x00000000,0x00040005,0x00000004,0x6c6f4366,0x0000726f,0x00040047,
+		0x00000003,0x0000001e,0x00000000,0x00040047,0x00000007,0x00000022,0x00000001,0x00040047,
+		0x00000007,0x00000021,0x00000000,0x00050048,0x00000008,0x00000000,0x00000023,0x00000000,
+		0x00030047,0x00000008,0x00000002,0x00030047,0x0000000a,0x000014b4,0x00030047,0x0000000b,
+		0x000014b4,0x00030047,0x0000000c,0x000014b4,0x00040047,0x00000004,0x0000001e,0x00000000,
+		0x00020013,0x0000000d,0x00030021,0x0000000e,0x0000000d,0x00030016,0x0000000f,0x00000020,
+		0x00040017,0x00000010,0x0000000f,0x00000004,0x00040020,0x00000011,0x00000007,0x00000010,
+		0x00040017,0x00000012,0x0000000f,0x00000002,0x0004001e,0x00000006,0x00000010,0x00000012,
+		0x00040020,0x00000013,0x00000001,0x00000006,0x0004003b,0x00000013,0x00000003,0x00000001,
+		0x00040015,0x00000014,0x00000020,0x00000001,0x0004002b,0x00000014,0x00000015,0x00000000,
+		0x00040020,0x00000016,0x00000001,0x00000010,0x00090019,0x00000017,0x0000000f,0x00000001,
+		0x00000000,0x00000000,0x00000000,0x00000001,0x00000000,0x0003001b,0x00000018,0x00000017,
+		0x0003001d,0x00000019,0x00000018,0x00040020,0x0000001a,0x00000000,0x00000019,0x0004003b,
+		0x0000001a,0x00000007,0x00000000,0x00040015,0x0000001b,0x00000020,0x00000000,0x0003001e,
+		0x00000008,0x0000001b,0x00040020,0x0000001c,0x00000009,0x00000008,0x0004003b,0x0000001c,
+		0x00000009,0x00000009,0x00040020,0x0000001d,0x00000009,0x0000001b,0x00040020,0x0000001e,
+		0x00000000,0x00000018,0x0004002b,0x00000014,0x0000001f,0x00000001,0x00040020,0x00000020,
+		0x00000001,0x00000012,0x0004002b,0x0000001b,0x00000021,0x00000003,0x00040020,0x00000022,
+		0x00000007,0x0000000f,0x0004002b,0x0000000f,0x00000023,0x00000000,0x00020014,0x00000024,
+		0x00040020,0x00000025,0x00000003,0x00000010,0x0004003b,0x00000025,0x00000004,0x00000003,
+		0x00050036,0x0000000d,0x00000002,0x00000000,0x0000000e,0x000200f8,0x00000026,0x0004003b,
+		0x00000011,0x00000005,0x00000007,0x00050041,0x00000016,0x00000027,0x00000003,0x00000015,
+		0x0004003d,0x00000010,0x00000028,0x00000027,0x00050041,0x0000001d,0x00000029,0x00000009,
+		0x00000015,0x0004003d,0x0000001b,0x0000000a,0x00000029,0x00050041,0x0000001e,0x0000000b,
+		0x00000007,0x0000000a,0x0004003d,0x00000018,0x0000000c,0x0000000b,0x00050041,0x00000020,
+		0x0000002a,0x00000003,0x0000001f,0x0004003d,0x00000012,0x0000002b,0x0000002a,0x00050057,
+		0x00000010,0x0000002c,0x0000000c,0x0000002b,0x00050085,0x00000010,0x0000002d,0x00000028,
+		0x0000002c,0x0003003e,0x00000005,0x0000002d,0x00050041,0x00000022,0x0000002e,0x00000005,
+		0x00000021,0x0004003d,0x0000000f,0x0000002f,0x0000002e,0x000500b4,0x00000024,0x00000030,
+		0x0000002f,0x00000023,0x000300f7,0x00000031,0x00000000,0x000400fa,0x00000030,0x00000032,
+		0x00000031,0x000200f8,0x00000032,0x000100fc,0x000200f8,0x00000031,0x0004003d,0x00000010,
+		0x00000033,0x00000005,0x0003003e,0x00000004,0x00000033,0x000100fd,0x00010038
+	};
+
+	/**
+			#version 450 core
+
+			layout(location = 0) in vec2 aPos; // per instance
+			layout(location = 1) in vec2 aSize; // per instance
+			layout(location = 2) in vec4 aUV; // per instance, offset in xy and size in zw
+			layout(location = 3) in vec4 aColor; // per instance
+
+			layout(set = 0, binding = 0) uniform uProjection {
+				mat4 mat;
+			} uProj;
+
+			out gl_PerVertex {
+				vec4 gl_Position;
+			};
+
+			layout(location = 0) out struct {
+				vec4 Color;
+				vec2 UV;
+			} Out;
+
+			void main()
+			{
+				// corners of the quad, drawn as a four vertices triangle strip
+				vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+				Out.Color = aColor;
+				Out.UV = aUV.xy + corner * aUV.zw;
+				vec2 pos = aPos + corner * aSize;
+				gl_Position = uProj.mat * vec4(pos.x, pos.y, 0.0, 1.0);
+			}
+	*/
+	const std::vector<std::uint32_t> sprite_vertex_shader = {	// precompiled instanced vertex shader
+		0x07230203,0x00010000,0x0008000b,0x0000003c,0x00000000,0x00020011,0x00000001,0x0006000b,
+		0x00000001,0x4c534c47,0x6474732e,0x3035342e,0x00000000,0x0003000e,0x00000000,0x00000001,
+		0x000c000f,0x00000000,0x00000002,0x6e69616d,0x00000000,0x00000003,0x00000004,0x00000005,
+		0x00000006,0x00000007,0x00000008,0x00000009,0x00030003,0x00000002,0x000001c2,0x00040005,
+		0x00000002,0x6e69616d,0x00000000,0x00060005,0x00000003,0x565f6c67,0x65747265,0x646e4978,
+		0x00007865,0x00030005,0x0000000a,0x00000000,0x00050006,0x0000000a,0x00000000,0x6f6c6f43,
+		0x00000072,0x00040006,0x0000000a,0x00000001,0x00005655,0x00030005,0x00000004,0x0074754f,
+		0x00040005,0x00000005,0x736f5061,0x00000000,0x00040005,0x00000006,0x7a695361,0x00000065,
+		0x00030005,0x00000007,0x00565561,0x00040005,0x00000008,0x6c6f4361,0x0000726f,0x00050005,
+		0x0000000b,0x6f725075,0x7463656a,0x006e6f69,0x00040006,0x0000000b,0x00000000,0x0074616d,
+		0x00040005,0x0000000c,0x6f725075,0x0000006a,0x00060005,0x0000000d,0x505f6c67,0x65567265,
+		0x78657472,0x00000000,0x00060006,0x0000000d,0x00000000,0x505f6c67,0x7469736f,0x006e6f69,
+		0x00030005,0x00000009,0x00000000,0x00040047,0x00000003,0x0000000b,0x0000002a,0x00040047,
+		0x00000004,0x0000001e,0x00000000,0x00040047,0x00000005,0x0000001e,0x00000000,0x00040047,
+		0x00000006,0x0000001e,0x00000001,0x00040047,0x00000007,0x0000001e,0x00000002,0x00040047,
+		0x00000008,0x0000001e,0x00000003,0x00040048,0x0000000b,0x00000000,0x00000005,0x00050048,
+		0x0000000b,0x00000000,0x00000023,0x00000000,0x00050048,0x0000000b,0x00000000,0x00000007,
+		0x00000010,0x00030047,0x0000000b,0x00000002,0x00040047,0x0000000c,0x00000022,0x00000000,
+		0x00040047,0x0000000c,0x00000021,0x00000000,0x00050048,0x0000000d,0x00000000,0x0000000b,
+		0x00000000,0x00030047,0x0000000d,0x00000002,0x00020013,0x0000000e,0x00030021,0x0000000f,
+		0x0000000e,0x00030016,0x00000010,0x00000020,0x00040017,0x00000011,0x00000010,0x00000004,
+		0x00040017,0x00000012,0x00000010,0x00000002,0x00040015,0x00000013,0x00000020,0x00000001,
+		0x00040020,0x00000014,0x00000001,0x00000013,0x0004003b,0x00000014,0x00000003,0x00000001,
+		0x0004002b,0x00000013,0x00000015,0x00000000,0x0004002b,0x00000013,0x00000016,0x00000001,
+		0x0004001e,0x0000000a,0x00000011,0x00000012,0x00040020,0x00000017,0x00000003,0x0000000a,
+		0x0004003b,0x00000017,0x00000004,0x00000003,0x0004002b,0x00000010,0x00000018,0x00000000,
+		0x0004002b,0x00000010,0x00000019,0x3f800000,0x00040020,0x0000001a,0x00000003,0x00000011,
+		0x00040020,0x0000001b,0x00000003,0x00000012,0x00040020,0x0000001c,0x00000001,0x00000012,
+		0x0004003b,0x0000001c,0x00000005,0x00000001,0x0004003b,0x0000001c,0x00000006,0x00000001,
+		0x00040020,0x0000001d,0x00000001,0x00000011,0x0004003b,0x0000001d,0x00000007,0x00000001,
+		0x0004003b,0x0000001d,0x00000008,0x00000001,0x00040018,0x0000001e,0x00000011,0x00000004,
+		0x0003001e,0x0000000b,0x0000001e,0x00040020,0x0000001f,0x00000002,0x0000000b,0x0004003b,
+		0x0000001f,0x0000000c,0x00000002,0x00040020,0x00000020,0x00000002,0x0000001e,0x0003001e,
+		0x0000000d,0x00000011,0x00040020,0x00000021,0x00000003,0x0000000d,0x0004003b,0x00000021,
+		0x00000009,0x00000003,0x00050036,0x0000000e,0x00000002,0x00000000,0x0000000f,0x000200f8,
+		0x00000022,0x0004003d,0x00000013,0x00000023,0x00000003,0x000500c7,0x00000013,0x00000024,
+		0x00000023,0x00000016,0x000500c3,0x00000013,0x00000025,0x00000023,0x00000016,0x0004006f,
+		0x00000010,0x00000026,0x00000024,0x0004006f,0x00000010,0x00000027,0x00000025,0x00050050,
+		0x00000012,0x00000028,0x00000026,0x00000027,0x0004003d,0x00000011,0x00000029,0x00000008,
+		0x00050041,0x0000001a,0x0000002a,0x00000004,0x00000015,0x0003003e,0x0000002a,0x00000029,
+		0x0004003d,0x00000011,0x0000002b,0x00000007,0x0007004f,0x00000012,0x0000002c,0x0000002b,
+		0x0000002b,0x00000000,0x00000001,0x0007004f,0x00000012,0x0000002d,0x0000002b,0x0000002b,
+		0x00000002,0x00000003,0x00050085,0x00000012,0x0000002e,0x00000028,0x0000002d,0x00050081,
+		0x00000012,0x0000002f,0x0000002c,0x0000002e,0x00050041,0x0000001b,0x00000030,0x00000004,
+		0x00000016,0x0003003e,0x00000030,0x0000002f,0x0004003d,0x00000012,0x00000031,0x00000005,
+		0x0004003d,0x00000012,0x00000032,0x00000006,0x00050085,0x00000012,0x00000033,0x00000028,
+		0x00000032,0x00050081,0x00000012,0x00000034,0x00000031,0x00000033,0x00050041,0x00000020,
+		0x00000035,0x0000000c,0x00000015,0x0004003d,0x0000001e,0x00000036,0x00000035,0x00050051,
+		0x00000010,0x00000037,0x00000034,0x00000000,0x00050051,0x00000010,0x00000038,0x00000034,
+		0x00000001,0x00070050,0x00000011,0x00000039,0x00000037,0x00000038,0x00000018,0x00000019,
+		0x00050091,0x00000011,0x0000003a,0x00000036,0x00000039,0x00050041,0x0000001a,0x0000003b,
+		0x00000009,0x00000015,0x0003003e,0x0000003b,0x0000003a,0x000100fd,0x00010038
+	};
 
+	void GraphicPipeline::init(Renderer& renderer, kind type)
+	{
+		MLX_PROFILE_FUNCTION();
+		_type = type;
 		VkPushConstantRange push_constant;
 		push_constant.offset = 0;
 		push_constant.size = sizeof(glm::vec2);
 		push_constant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
+		VkDescriptorSetLayout layouts[] = {
+			renderer.getVertDescriptorSetLayout().get(),
+			renderer.getFragDescriptorSetLayout().get()
+		};
+
+		if(_type == kind::bindless_sprites) // the texture comes from the texture table, its index is pushed for each draw
+		{
+			push_constant.size = sizeof(std::uint32_t);
+			push_constant.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+			layouts[1] = Render_Core::get().getTextureTable().getLayout();
+		}
+
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutInfo.setLayoutCount = 2;
+		pipelineLayoutInfo.pSetLayouts = layouts;
+		pipelineLayoutInfo.pushConstantRangeCount = 1;
+		pipelineLayoutInfo.pPushConstantRanges = &push_constant;
+
+		if(vkCreatePipelineLayout(Render_Core::get().getDevice().get(), &pipelineLayoutInfo, nullptr, &_pipeline_layout) != VK_SUCCESS)
+			core::error::report(e_kind::fatal_error, "Vulkan : failed to create a graphics pipeline layout");
+
+		VkRenderPass pass = renderer.getRenderPass().get();
+		VkExtent2D extent = { renderer.getFrameBuffer(0).getWidth(), renderer.getFrameBuffer(0).getHeight() };
+
+		// building the pipeline is the slowest part of the creation of a renderer,
+		// it runs in the background until the first frame needs to bind it
+		_creation = std::async(std::launch::async, [this, pass, extent]() { createPipeline(pass, extent); });
+	}
+
+	void GraphicPipeline::createPipeline(VkRenderPass pass, VkExtent2D extent)
+	{
+		VkShaderModuleCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		const bool sprites = (_type != kind::meshes);
+		const std::vector<std::uint32_t>& vertex_code = (sprites ? sprite_vertex_shader : vertex_shader);
+		const std::vector<std::uint32_t>& fragment_code = (_type == kind::bindless_sprites ? bindless_fragment_shader : fragment_shader);
+		createInfo.codeSize = vertex_code.size() * sizeof(std::uint32_t);
+		createInfo.pCode = vertex_code.data();
+		VkShaderModule vshader;
+		if(vkCreateShaderModule(Render_Core::get().getDevice().get(), &createInfo, nullptr, &vshader) != VK_SUCCESS)
+			core::error::report(e_kind::fatal_error, "Vulkan : failed to create a vertex shader module");
+
 		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-		createInfo.codeSize = fragment_shader.size() * sizeof(std::uint32_t);
-		createInfo.pCode = fragment_shader.data();
+		createInfo.codeSize = fragment_code.size() * sizeof(std::uint32_t);
+		createInfo.pCode = fragment_code.data();
 		VkShaderModule fshader;
 		if(vkCreateShaderModule(Render_Core::get().getDevice().get(), &createInfo, nullptr, &fshader) != VK_SUCCESS)
 			core::error::report(e_kind::fatal_error, "Vulkan : failed to create a fragment shader module");
@@ -198,17 +393,28 @@ namespace mlx
 
 		auto bindingDescription = Vertex::getBindingDescription();
 		auto attributeDescriptions = Vertex::getAttributeDescriptions();
+		auto spriteBindingDescription = SpriteInstance::getBindingDescription();
+		auto spriteAttributeDescriptions = SpriteInstance::getAttributeDescriptions();
 
 		VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo{};
 		vertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 		vertexInputStateCreateInfo.vertexBindingDescriptionCount = 1;
-		vertexInputStateCreateInfo.pVertexBindingDescriptions = &bindingDescription;
-		vertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<std::uint32_t>(attributeDescriptions.size());
-		vertexInputStateCreateInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+		if(sprites)
+		{
+			vertexInputStateCreateInfo.pVertexBindingDescriptions = &spriteBindingDescription;
+			vertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<std::uint32_t>(spriteAttributeDescriptions.size());
+			vertexInputStateCreateInfo.pVertexAttributeDescriptions = spriteAttributeDescriptions.data();
+		}
+		else
+		{
+			vertexInputStateCreateInfo.pVertexBindingDescriptions = &bindingDescription;
+			vertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<std::uint32_t>(attributeDescriptions.size());
+			vertexInputStateCreateInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+		}
 
 		VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
 		inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-		inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		inputAssembly.topology = (sprites ? VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP : VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
 		inputAssembly.primitiveRestartEnable = VK_FALSE;
 
 		VkDynamicState states[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
@@ -222,14 +428,14 @@ namespace mlx
 		VkViewport viewport{};
 		viewport.x = 0.0f;
 		viewport.y = 0.0f;
-		viewport.width = (float)renderer.getFrameBuffer(0).getWidth();
-		viewport.height = (float)renderer.getFrameBuffer(0).getHeight();
+		viewport.width = (float)extent.width;
+		viewport.height = (float)extent.height;
 		viewport.minDepth = 0.0f;
 		viewport.maxDepth = 1.0f;
 
 		VkRect2D scissor{};
 		scissor.offset = { 0, 0 };
-		scissor.extent = { renderer.getFrameBuffer(0).getWidth(), renderer.getFrameBuffer(0).getHeight()};
+		scissor.extent = extent;
 
 		VkPipelineViewportStateCreateInfo viewportState{};
 		viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
@@ -274,21 +480,6 @@ namespace mlx
 		colorBlending.blendConstants[2] = 1.0f;
 		colorBlending.blendConstants[3] = 1.0f;
 
-		VkDescriptorSetLayout layouts[] = {
-			renderer.getVertDescriptorSetLayout().get(),
-			renderer.getFragDescriptorSetLayout().get()
-		};
-
-		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		pipelineLayoutInfo.setLayoutCount = 2;
-		pipelineLayoutInfo.pSetLayouts = layouts;
-		pipelineLayoutInfo.pushConstantRangeCount = 1;
-		pipelineLayoutInfo.pPushConstantRanges = &push_constant;
-
-		if(vkCreatePipelineLayout(Render_Core::get().getDevice().get(), &pipelineLayoutInfo, nullptr, &_pipeline_layout) != VK_SUCCESS)
-			core::error::report(e_kind::fatal_error, "Vulkan : failed to create a graphics pipeline layout");
-
 		VkGraphicsPipelineCreateInfo pipelineInfo{};
 		pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
 		pipelineInfo.stageCount = stages.size();
@@ -301,11 +492,11 @@ namespace mlx
 		pipelineInfo.pColorBlendState = &colorBlending;
 		pipelineInfo.pDynamicState = &dynamicStates;
 		pipelineInfo.layout = _pipeline_layout;
-		pipelineInfo.renderPass = renderer.getRenderPass().get();
+		pipelineInfo.renderPass = pass;
 		pipelineInfo.subpass = 0;
 		pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-		VkResult res = vkCreateGraphicsPipelines(Render_Core::get().getDevice().get(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &_graphics_pipeline);
+		VkResult res = vkCreateGraphicsPipelines(Render_Core::get().getDevice().get(), Render_Core::get().getPipelineCache().get(), 1, &pipelineInfo, nullptr, &_graphics_pipeline);
 		if(res != VK_SUCCESS)
 			core::error::report(e_kind::fatal_error, "Vulkan : failed to create a graphics pipeline, %s", RCore::verbaliseResultVk(res));
 #ifdef DEBUG
@@ -316,8 +507,17 @@ namespace mlx
 		vkDestroyShaderModule(Render_Core::get().getDevice().get(), vshader, nullptr);
 	}
 
+	void GraphicPipeline::waitReady()
+	{
+		if(!_creation.valid())
+			return;
+		MLX_PROFILE_FUNCTION();
+		_creation.get();
+	}
+
 	void GraphicPipeline::destroy() noexcept
 	{
+		waitReady();
 		vkDestroyPipeline(Render_Core::get().getDevice().get(), _graphics_pipeline, nullptr);
 		vkDestroyPipelineLayout(Render_Core::get().getDevice().get(), _pipeline_layout, nullptr);
 		_graphics_pipeline = VK_NULL_HANDLE;
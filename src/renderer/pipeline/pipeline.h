@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/12/18 21:23:52 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:04:28 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:20:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,23 +16,38 @@
 #include <mlx_profile.h>
 #include <volk.h>
 #include <renderer/command/vk_cmd_buffer.h>
+#include <future>
 
 namespace mlx
 {
 	class GraphicPipeline
 	{
 		public:
-			void init(class Renderer& renderer);
+			enum class kind
+			{
+				meshes = 0, // indexed vertex buffers, translated by a push constant
+				sprites, // instanced quads, one instance per sprite
+				bindless_sprites, // instanced quads sampling the texture table, needs descriptor indexing
+			};
+
+		public:
+			void init(class Renderer& renderer, kind type = kind::meshes); // the pipeline itself is created in the background
+			void waitReady();
 			void destroy() noexcept;
 
-			inline void bindPipeline(CmdBuffer& command_buffer) noexcept { vkCmdBindPipeline(command_buffer.get(), VK_PIPELINE_BIND_POINT_GRAPHICS, _graphics_pipeline); }
+			inline void bindPipeline(CmdBuffer& command_buffer) { waitReady(); vkCmdBindPipeline(command_buffer.get(), VK_PIPELINE_BIND_POINT_GRAPHICS, _graphics_pipeline); }
 
-			inline const VkPipeline& getPipeline() const noexcept { return _graphics_pipeline; }
+			inline const VkPipeline& getPipeline() { waitReady(); return _graphics_pipeline; }
 			inline const VkPipelineLayout& getPipelineLayout() const noexcept { return _pipeline_layout; }
 
 		private:
+			void createPipeline(VkRenderPass pass, VkExtent2D extent);
+
+		private:
+			std::future<void> _creation;
 			VkPipeline _graphics_pipeline = VK_NULL_HANDLE;
 			VkPipelineLayout _pipeline_layout = VK_NULL_HANDLE;
+			kind _type = kind::meshes;
 	};
 }
 
@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pipeline_cache.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:09:27 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:10:14 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <renderer/pipeline/pipeline_cache.h>
+#include <renderer/core/render_core.h>
+#include <core/profiler.h>
+#include <fstream>
+#include <iterator>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <cstdio>
+
+namespace mlx
+{
+	void PipelineCache::init()
+	{
+		MLX_PROFILE_FUNCTION();
+		vkGetPhysicalDeviceProperties(Render_Core::get().getDevice().getPhysicalDevice(), &_properties);
+		_path = getCachePath();
+
+		std::vector<char> data;
+		std::ifstream file(_path, std::ios::binary);
+		if(file.is_open())
+			data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+		// drivers should reject foreign data by themselves but some of them do not check the header
+		if(data.size() >= 16 + VK_UUID_SIZE)
+		{
+			std::uint32_t header[4];
+			std::memcpy(header, data.data(), sizeof(header));
+			if(header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE || header[2] != _properties.vendorID || header[3] != _properties.deviceID || std::memcmp(data.data() + 16, _properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+				data.clear();
+		}
+		else
+			data.clear();
+
+		VkPipelineCacheCreateInfo info{};
+		info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		info.initialDataSize = data.size();
+		info.pInitialData = data.empty() ? nullptr : data.data();
+		VkResult res = vkCreatePipelineCache(Render_Core::get().getDevice().get(), &info, nullptr, &_cache);
+		if(res != VK_SUCCESS && !data.empty())
+		{
+			info.initialDataSize = 0;
+			info.pInitialData = nullptr;
+			res = vkCreatePipelineCache(Render_Core::get().getDevice().get(), &info, nullptr, &_cache);
+		}
+		if(res != VK_SUCCESS)
+		{
+			core::error::report(e_kind::error, "Vulkan : failed to create a pipeline cache, %s", RCore::verbaliseResultVk(res));
+			_cache = VK_NULL_HANDLE;
+			return;
+		}
+		#ifdef DEBUG
+			core::error::report(e_kind::message, "Vulkan : created pipeline cache (%zu bytes loaded from '%s')", data.size(), _path.string().c_str());
+		#endif
+	}
+
+	std::filesystem::path PipelineCache::getCachePath() const
+	{
+		std::filesystem::path dir;
+		if(const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg != nullptr && *xdg != '\0')
+			dir = xdg;
+		else if(const char* home = std::getenv("HOME"); home != nullptr && *home != '\0')
+			dir = std::filesystem::path(home) / ".cache";
+		else
+		{
+			std::error_code err;
+			dir = std::filesystem::temp_directory_path(err);
+		}
+		dir /= "mlx";
+
+		char uuid[VK_UUID_SIZE * 2 + 1];
+		for(std::size_t i = 0; i < VK_UUID_SIZE; i++)
+			std::snprintf(uuid + i * 2, 3, "%02x", _properties.pipelineCacheUUID[i]);
+		char name[128];
+		std::snprintf(name, sizeof(name), "pipeline_cache_%s_%x.bin", uuid, _properties.driverVersion);
+		return dir / name;
+	}
+
+	void PipelineCache::save() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		std::size_t size = 0;
+		if(vkGetPipelineCacheData(Render_Core::get().getDevice().get(), _cache, &size, nullptr) != VK_SUCCESS || size == 0)
+			return;
+		std::vector<char> data(size);
+		if(vkGetPipelineCacheData(Render_Core::get().getDevice().get(), _cache, &size, data.data()) != VK_SUCCESS)
+			return;
+
+		std::error_code err;
+		std::filesystem::create_directories(_path.parent_path(), err);
+		// written aside and renamed so a concurrent run never reads a half written file
+		std::filesystem::path tmp = _path;
+		tmp += ".tmp";
+		{
+			std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+			if(!file.is_open())
+				return;
+			file.write(data.data(), static_cast<std::streamsize>(size));
+			if(!file.good())
+				return;
+		}
+		std::filesystem::rename(tmp, _path, err);
+		if(err)
+			std::filesystem::remove(tmp, err);
+	}
+
+	void PipelineCache::destroy() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_cache == VK_NULL_HANDLE)
+			return;
+		save();
+		vkDestroyPipelineCache(Render_Core::get().getDevice().get(), _cache, nullptr);
+		_cache = VK_NULL_HANDLE;
+	}
+}
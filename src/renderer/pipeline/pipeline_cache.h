@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pipeline_cache.h                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:09:26 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:10:14 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_PIPELINE_CACHE__
+#define __MLX_PIPELINE_CACHE__
+
+#include <mlx_profile.h>
+#include <volk.h>
+#include <filesystem>
+
+namespace mlx
+{
+	/**
+	 * VkPipelineCache persisted between runs.
+	 * The file name holds the pipeline cache UUID and the driver version of the
+	 * device so a driver update or another GPU never reads a foreign blob.
+	 */
+	class PipelineCache
+	{
+		public:
+			PipelineCache() = default;
+
+			void init();
+			void destroy() noexcept; // saves the cache to disk before destroying it
+
+			inline VkPipelineCache get() const noexcept { return _cache; }
+
+			~PipelineCache() = default;
+
+		private:
+			std::filesystem::path getCachePath() const;
+			void save() noexcept;
+
+		private:
+			VkPhysicalDeviceProperties _properties{};
+			std::filesystem::path _path;
+			VkPipelineCache _cache = VK_NULL_HANDLE;
+	};
+}
+
+#endif
@@ -6,12 +6,13 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/03/31 15:14:50 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/11 00:06:01 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:04:29 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <renderer/pixel_put.h>
-#include <cstring>
+#include <renderer/renderer.h>
+#include <renderer/buffers/staging_ring.h>
 #include <core/profiler.h>
 
 namespace mlx
@@ -22,46 +23,54 @@ namespace mlx
 		_texture.create(nullptr, width, height, VK_FORMAT_R8G8B8A8_UNORM, "__mlx_pixel_put_pipeline_texture", true);
 		_texture.setDescriptor(renderer.getFragDescriptorSet().duplicate());
 
-		_buffer.create(Buffer::kind::dynamic, sizeof(std::uint32_t) * (width * height), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, "__mlx_pixel_put_pipeline_texture");
-		_buffer.mapMem(&_buffer_map);
-		_cpu_map = std::vector<std::uint32_t>(height * width + 1, 0);
+		_cpu_map = std::vector<std::uint32_t>(height * width, 0);
 		_width = width;
 		_height = height;
+		_dirty_tiles.init(width, height);
+		_dirty_tiles.markAll();
 	}
 
 	void PixelPutPipeline::setPixel(int x, int y, std::uint32_t color) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		if(x < 0 || y < 0 || x > static_cast<int>(_width) || y > static_cast<int>(_height))
+		if(x < 0 || y < 0 || x >= static_cast<int>(_width) || y >= static_cast<int>(_height))
 			return;
 		_cpu_map[(y * _width) + x] = color;
-		_has_been_modified = true;
+		_dirty_tiles.mark(x, y);
 	}
 
 	void PixelPutPipeline::clear()
 	{
 		MLX_PROFILE_FUNCTION();
 		_cpu_map.assign(_width * _height, 0);
-		_has_been_modified = true;
+		_dirty_tiles.markAll();
+	}
+
+	void PixelPutPipeline::update(Renderer& renderer) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!_dirty_tiles.isDirty())
+			return;
+		// staged apart for each frame, the copies of the frames in flight may still be reading theirs
+		CmdBuffer& cmd = renderer.getActiveCmdBuffer();
+		StagingRing& ring = StagingRing::get();
+		StagingRing::Allocation staging = ring.allocate(_dirty_tiles.getDirtySize(sizeof(std::uint32_t)), StagingRing::DEFAULT_ALIGNMENT, &cmd);
+		renderer.getFrameCounters().uploaded_bytes += _dirty_tiles.flush(_cpu_map.data(), staging.data, staging.offset, sizeof(std::uint32_t), _upload_regions);
+		ring.flush(staging);
+		_texture.copyFromBuffer(*staging.buffer, _upload_regions, &cmd);
 	}
 
 	void PixelPutPipeline::render(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		if(_has_been_modified)
-		{
-			std::memcpy(_buffer_map, _cpu_map.data(), sizeof(std::uint32_t) * _cpu_map.size());
-			_texture.copyFromBuffer(_buffer);
-			_has_been_modified = false;
-		}
-		_texture.updateSet(0);
-		_texture.render(sets, renderer, 0, 0);
+		renderer.getSpriteBatch().flush(sets, renderer); // images put before are timed as such
+		renderer.getSpriteBatch().push(&_texture, 0, 0);
+		renderer.getSpriteBatch().flush(sets, renderer, GPUTimeCategory::pixel_put);
 	}
 
 	void PixelPutPipeline::destroy() noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		_buffer.destroy();
 		_texture.destroy();
 	}
 
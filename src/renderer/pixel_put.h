@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/03/31 13:18:50 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/11 00:06:05 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:04:29 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,6 +15,7 @@
 
 #include <mlx_profile.h>
 #include <renderer/images/texture.h>
+#include <renderer/images/dirty_tiles.h>
 #include <renderer/descriptors/vk_descriptor_set.h>
 
 namespace mlx
@@ -27,6 +28,7 @@ namespace mlx
 			void init(std::uint32_t width, std::uint32_t height, class Renderer& renderer) noexcept;
 
 			void setPixel(int x, int y, std::uint32_t color) noexcept;
+			void update(class Renderer& renderer) noexcept;
 			void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer) noexcept;
 
 			void clear();
@@ -36,13 +38,12 @@ namespace mlx
 
 		private:
 			Texture _texture;
-			Buffer _buffer;
 			// using vector as CPU map and not directly writting to mapped buffer to improve performances
 			std::vector<std::uint32_t> _cpu_map;
-			void* _buffer_map = nullptr;
+			std::vector<VkBufferImageCopy> _upload_regions;
+			DirtyTiles _dirty_tiles;
 			std::uint32_t _width = 0;
 			std::uint32_t _height = 0;
-			bool _has_been_modified = true;
 	};
 }
 
@@ -0,0 +1,159 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   readback.cpp                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:19:47 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:33:48 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#include <renderer/readback.h>
+#include <renderer/images/vk_image.h>
+#include <renderer/command/vk_cmd_buffer.h>
+#include <core/profiler.h>
+#include <core/errors.h>
+#include <algorithm>
+#include <cstring>
+
+namespace mlx
+{
+	static inline bool isRGBA(VkFormat format) noexcept
+	{
+		return format == VK_FORMAT_R8G8B8A8_UNORM || format == VK_FORMAT_R8G8B8A8_SRGB;
+	}
+
+	static inline bool isBGRA(VkFormat format) noexcept
+	{
+		return format == VK_FORMAT_B8G8R8A8_UNORM || format == VK_FORMAT_B8G8R8A8_SRGB;
+	}
+
+	void ReadbackQueue::request(Image* image, ReadbackCallback callback)
+	{
+		MLX_PROFILE_FUNCTION();
+		_requests.push_back(Request{ image, std::move(callback), nullptr });
+	}
+
+	void ReadbackQueue::requestMapped(Image* image, ReadbackMappedCallback callback)
+	{
+		MLX_PROFILE_FUNCTION();
+		_requests.push_back(Request{ image, nullptr, std::move(callback) });
+	}
+
+	void ReadbackQueue::forget(Image* image) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		_requests.erase(std::remove_if(_requests.begin(), _requests.end(), [image](const Request& request) { return request.image == image; }), _requests.end());
+	}
+
+	void ReadbackQueue::record(CmdBuffer& cmd, Image& frame_target, std::uint32_t frame_index)
+	{
+		if(_requests.empty())
+			return;
+		MLX_PROFILE_FUNCTION();
+		std::size_t recorded = 0;
+		for(Slot& slot : _slots)
+		{
+			if(recorded == _requests.size())
+				break;
+			if(slot.in_flight)
+				continue;
+			Request& request = _requests[recorded];
+			Image& image = (request.image != nullptr ? *request.image : frame_target);
+			if(!isRGBA(image.getFormat()) && !isBGRA(image.getFormat()))
+			{
+				core::error::report(e_kind::error, "Vulkan : cannot read back an image that is not using 8 bits RGBA or BGRA pixels");
+				recorded++;
+				continue;
+			}
+
+			VkDeviceSize size = static_cast<VkDeviceSize>(image.getWidth()) * image.getHeight() * 4;
+			if(slot.buffer.get() != VK_NULL_HANDLE && slot.buffer.getSize() < size)
+				slot.buffer.destroy();
+			if(slot.buffer.get() == VK_NULL_HANDLE)
+			{
+				#ifdef DEBUG
+					slot.buffer.create(Buffer::kind::readback, size, 0, "__mlx_readback_buffer");
+				#else
+					slot.buffer.create(Buffer::kind::readback, size, 0, nullptr);
+				#endif
+			}
+
+			// the image goes back to the layout it was in so the rest of the renderer does not notice the copy
+			VkImageLayout layout = image.getLayout();
+			image.transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, &cmd);
+			cmd.copyImagetoBuffer(image, slot.buffer);
+			image.transitionLayout(layout, &cmd);
+
+			slot.callback = std::move(request.callback);
+			slot.mapped_callback = std::move(request.mapped_callback);
+			slot.format = image.getFormat();
+			slot.width = image.getWidth();
+			slot.height = image.getHeight();
+			slot.frame_index = frame_index;
+			slot.in_flight = true;
+			recorded++;
+		}
+		_requests.erase(_requests.begin(), _requests.begin() + recorded);
+
+		// makes the copies visible to the host once the frame fence is signaled
+		VkMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+		vkCmdPipelineBarrier(cmd.get(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+	}
+
+	void ReadbackQueue::deliver(std::uint32_t frame_index)
+	{
+		MLX_PROFILE_FUNCTION();
+		for(Slot& slot : _slots)
+		{
+			if(!slot.in_flight || slot.frame_index != frame_index)
+				continue;
+			slot.in_flight = false;
+			ReadbackCallback callback = std::move(slot.callback);
+			ReadbackMappedCallback mapped_callback = std::move(slot.mapped_callback);
+			slot.callback = nullptr;
+			slot.mapped_callback = nullptr;
+
+			std::size_t count = static_cast<std::size_t>(slot.width) * slot.height;
+			void* map = nullptr;
+			slot.buffer.invalidate();
+			slot.buffer.mapMem(&map);
+			if(mapped_callback)
+			{
+				mapped_callback(static_cast<const std::uint32_t*>(map), slot.width, slot.height, !isBGRA(slot.format));
+				slot.buffer.unmapMem();
+				continue;
+			}
+			_pixels.resize(count);
+			std::memcpy(_pixels.data(), map, count * sizeof(std::uint32_t));
+			slot.buffer.unmapMem();
+
+			// little endian BGRA bytes already read as 0xAARRGGBB, RGBA ones need their red and blue swapped
+			if(!isBGRA(slot.format))
+			{
+				for(std::uint32_t& color : _pixels)
+					color = (color & 0xFF00FF00) | ((color & 0x00FF0000) >> 16) | ((color & 0x000000FF) << 16);
+			}
+			if(callback)
+				callback(_pixels.data(), slot.width, slot.height);
+		}
+	}
+
+	void ReadbackQueue::destroy() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		_requests.clear();
+		for(Slot& slot : _slots)
+		{
+			if(slot.buffer.get() != VK_NULL_HANDLE)
+				slot.buffer.destroy();
+			slot.callback = nullptr;
+			slot.mapped_callback = nullptr;
+			slot.in_flight = false;
+		}
+	}
+}
@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   readback.h                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:19:47 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:33:48 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#ifndef __MLX_READBACK__
+#define __MLX_READBACK__
+
+#include <mlx_profile.h>
+#include <volk.h>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <renderer/core/render_core.h>
+#include <renderer/buffers/vk_buffer.h>
+
+namespace mlx
+{
+	using ReadbackCallback = std::function<void(const std::uint32_t* pixels, std::uint32_t width, std::uint32_t height)>;
+	// pixels point straight into the mapped buffer and are only valid during the call, with red and blue swapped when swap_red_blue is set
+	using ReadbackMappedCallback = std::function<void(const std::uint32_t* pixels, std::uint32_t width, std::uint32_t height, bool swap_red_blue)>;
+
+	/**
+	 * Reads images back to the CPU without stalling the frame loop.
+	 * Requested copies are recorded at the end of the next frame command buffer
+	 * into host cached buffers taken from a small ring, and their callbacks are
+	 * called once the fence of that frame has been waited on, that is when the
+	 * same frame slot begins again (one or two frames later).
+	 * Requests that find no free buffer simply wait for a later frame.
+	 */
+	class ReadbackQueue
+	{
+		public:
+			static constexpr std::size_t RING_SIZE = MAX_FRAMES_IN_FLIGHT * 2;
+
+		public:
+			ReadbackQueue() = default;
+
+			// image == nullptr reads the frame target (swapchain image or render target) back
+			void request(class Image* image, ReadbackCallback callback);
+			// same without the intermediate copy and swizzle, for callers that copy the pixels anyway
+			void requestMapped(class Image* image, ReadbackMappedCallback callback);
+			// drops the requests targeting an image that is about to be destroyed
+			void forget(class Image* image) noexcept;
+			void record(class CmdBuffer& cmd, class Image& frame_target, std::uint32_t frame_index);
+			void deliver(std::uint32_t frame_index);
+			void destroy() noexcept;
+
+			inline bool hasRequests() const noexcept { return !_requests.empty(); }
+
+			~ReadbackQueue() = default;
+
+		private:
+			struct Request
+			{
+				class Image* image;
+				ReadbackCallback callback;
+				ReadbackMappedCallback mapped_callback;
+			};
+
+			struct Slot
+			{
+				Buffer buffer;
+				ReadbackCallback callback;
+				ReadbackMappedCallback mapped_callback;
+				VkFormat format = VK_FORMAT_UNDEFINED;
+				std::uint32_t width = 0;
+				std::uint32_t height = 0;
+				std::uint32_t frame_index = 0;
+				bool in_flight = false;
+			};
+
+		private:
+			std::array<Slot, RING_SIZE> _slots;
+			std::vector<Request> _requests;
+			std::vector<std::uint32_t> _pixels;
+	};
+}
+
+#endif
@@ -6,13 +6,14 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/12/18 17:25:16 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 16:34:43 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:20:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <renderer/renderer.h>
 #include <renderer/images/texture.h>
 #include <renderer/core/render_core.h>
+#include <renderer/buffers/staging_ring.h>
 #include <core/profiler.h>
 
 namespace mlx
@@ -59,7 +60,12 @@ namespace mlx
 
 		_vert_set.writeDescriptor(0, _uniform_buffer.get());
 
+		_timestamps.init();
+
 		_pipeline.init(*this);
+		_sprite_pipeline.init(*this, GraphicPipeline::kind::sprites);
+		if(Render_Core::get().getTextureTable().isEnabled())
+			_bindless_sprite_pipeline.init(*this, GraphicPipeline::kind::bindless_sprites);
 
 		_framebuffer_resized = false;
 	}
@@ -69,9 +75,13 @@ namespace mlx
 		MLX_PROFILE_FUNCTION();
 		auto device = Render_Core::get().getDevice().get();
 
+		_cmd.getCmdBuffer(_current_frame_index).waitForExecution();
+		Render_Core::get().getDeletionQueue().collect();
+		_readbacks.deliver(_current_frame_index); // the copies recorded the last time this frame slot was used are done
+		_timestamps.collect(_current_frame_index);
+		_frame_arena.reset();
 		if(_render_target == nullptr)
 		{
-			_cmd.getCmdBuffer(_current_frame_index).waitForExecution();
 			VkResult result = vkAcquireNextImageKHR(device, _swapchain(), UINT64_MAX, _semaphores[_current_frame_index].getImageSemaphore(), VK_NULL_HANDLE, &_image_index);
 
 			if(result == VK_ERROR_OUT_OF_DATE_KHR)
@@ -83,18 +93,30 @@ namespace mlx
 				core::error::report(e_kind::fatal_error, "Vulkan error : failed to acquire swapchain image");
 		}
 		else
-		{
 			_image_index = 0;
-			if(_render_target->getLayout() != VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL)
-				_render_target->transitionLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-		}
 
+		_counters = FrameCounters{};
+		_sprite_batch.newFrame(_current_frame_index);
 		_cmd.getCmdBuffer(_current_frame_index).reset();
 		_cmd.getCmdBuffer(_current_frame_index).beginRecord();
+		_timestamps.begin(_cmd.getCmdBuffer(_current_frame_index), _current_frame_index);
+
+		// from here until beginRenderPass the command buffer records the transfers of the frame
+		return true;
+	}
+
+	void Renderer::beginRenderPass()
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_render_target != nullptr && _render_target->getLayout() != VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL)
+			_render_target->transitionLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, &getActiveCmdBuffer());
+
 		auto& fb = _framebuffers[_image_index];
 		_pass.begin(getActiveCmdBuffer(), fb);
+		_timestamps.mark(getActiveCmdBuffer(), GPUTimeCategory::other);
 
-		_pipeline.bindPipeline(_cmd.getCmdBuffer(_current_frame_index));
+		_bound_pipeline = nullptr;
+		bindPipeline(_pipeline);
 
 		VkViewport viewport{};
 		viewport.x = 0.0f;
@@ -109,19 +131,24 @@ namespace mlx
 		scissor.offset = { 0, 0 };
 		scissor.extent = { fb.getWidth(), fb.getHeight()};
 		vkCmdSetScissor(_cmd.getCmdBuffer(_current_frame_index).get(), 0, 1, &scissor);
-
-		return true;
 	}
 
 	void Renderer::endFrame()
 	{
 		MLX_PROFILE_FUNCTION();
 		_pass.end(getActiveCmdBuffer());
+		_timestamps.mark(getActiveCmdBuffer(), GPUTimeCategory::other);
+		if(_render_target == nullptr)
+			_readbacks.record(getActiveCmdBuffer(), _swapchain.getImage(_image_index), _current_frame_index);
+		else
+			_readbacks.record(getActiveCmdBuffer(), *_render_target, _current_frame_index);
+		_timestamps.end(getActiveCmdBuffer());
 		_cmd.getCmdBuffer(_current_frame_index).endRecord();
 
 		if(_render_target == nullptr)
 		{
 			_cmd.getCmdBuffer(_current_frame_index).submit(&_semaphores[_current_frame_index]);
+			StagingRing::get().release(_cmd.getCmdBuffer(_current_frame_index));
 
 			VkSwapchainKHR swapchain = _swapchain();
 			VkSemaphore signalSemaphores[] = { _semaphores[_current_frame_index].getRenderImageSemaphore() };
@@ -147,13 +174,18 @@ namespace mlx
 		}
 		else
 		{
-			_cmd.getCmdBuffer(_current_frame_index).submitIdle(true);
+			// the next beginFrame waits for this submission with the frame fence
+			_cmd.getCmdBuffer(_current_frame_index).submit(nullptr);
+			StagingRing::get().release(_cmd.getCmdBuffer(_current_frame_index));
 			_current_frame_index = 0;
 		}
 	}
 
 	void Renderer::recreateRenderData()
 	{
+		_pipeline.waitReady(); // the pipelines may still be built against the render pass destroyed below
+		_sprite_pipeline.waitReady();
+		_bindless_sprite_pipeline.waitReady();
 		_swapchain.recreate();
 		_pass.destroy();
 		_pass.init(_swapchain.getImagesFormat(), VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
@@ -169,7 +201,16 @@ namespace mlx
 		MLX_PROFILE_FUNCTION();
 		vkDeviceWaitIdle(Render_Core::get().getDevice().get());
 
+		for(std::uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+			_readbacks.deliver(i);
+		_readbacks.destroy();
+		_timestamps.destroy();
+		_frame_arena.destroy();
 		_pipeline.destroy();
+		_sprite_pipeline.destroy();
+		if(Render_Core::get().getTextureTable().isEnabled())
+			_bindless_sprite_pipeline.destroy();
+		_sprite_batch.destroy();
 		_uniform_buffer->destroy();
 		_vert_layout.destroy();
 		_frag_layout.destroy();
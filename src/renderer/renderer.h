@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/12/18 17:14:45 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 16:34:20 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:20:35 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -28,6 +28,10 @@
 #include <renderer/descriptors/vk_descriptor_set.h>
 #include <renderer/descriptors/vk_descriptor_pool.h>
 #include <renderer/descriptors/vk_descriptor_set_layout.h>
+#include <renderer/sprite_batch.h>
+#include <renderer/readback.h>
+#include <renderer/frame_timestamps.h>
+#include <renderer/frame_arena.h>
 
 #include <core/errors.h>
 #include <mlx_profile.h>
@@ -79,12 +83,21 @@ namespace mlx
 
 	class Renderer
 	{
+		public:
+			struct FrameCounters
+			{
+				std::size_t uploaded_bytes = 0; // image data sent to the GPU
+				std::uint32_t draw_calls = 0;
+				std::uint32_t descriptor_binds = 0;
+			};
+
 		public:
 			Renderer() = default;
 
 			void init(class Texture* render_target);
 
 			bool beginFrame();
+			void beginRenderPass();
 			void endFrame();
 
 			void destroy();
@@ -99,6 +112,8 @@ namespace mlx
 			inline Semaphore& getSemaphore(int i) noexcept { return _semaphores[i]; }
 			inline RenderPass& getRenderPass() noexcept { return _pass; }
 			inline GraphicPipeline& getPipeline() noexcept { return _pipeline; }
+			inline GraphicPipeline& getSpritePipeline() noexcept { return _sprite_pipeline; }
+			inline GraphicPipeline& getBindlessSpritePipeline() noexcept { return _bindless_sprite_pipeline; } // only built when the texture table is enabled
 			inline CmdBuffer& getCmdBuffer(int i) noexcept { return _cmd.getCmdBuffer(i); }
 			inline CmdBuffer& getActiveCmdBuffer() noexcept { return _cmd.getCmdBuffer(_current_frame_index); }
 			inline FrameBuffer& getFrameBuffer(int i) noexcept { return _framebuffers[i]; }
@@ -111,6 +126,15 @@ namespace mlx
 
 			constexpr inline void requireFrameBufferResize() noexcept { _framebuffer_resized = true; }
 
+			inline void bindPipeline(GraphicPipeline& pipeline) { if(_bound_pipeline != &pipeline) { pipeline.bindPipeline(getActiveCmdBuffer()); _bound_pipeline = &pipeline; } }
+
+			inline SpriteBatch& getSpriteBatch() noexcept { return _sprite_batch; }
+			inline ReadbackQueue& getReadbacks() noexcept { return _readbacks; }
+			inline FrameTimestamps& getTimestamps() noexcept { return _timestamps; }
+			inline FrameArena& getFrameArena() noexcept { return _frame_arena; }
+			// counters of the frame being recorded (or of the last one once it ended)
+			inline FrameCounters& getFrameCounters() noexcept { return _counters; }
+
 			~Renderer() = default;
 
 		private:
@@ -118,6 +142,8 @@ namespace mlx
 
 		private:
 			GraphicPipeline _pipeline;
+			GraphicPipeline _sprite_pipeline;
+			GraphicPipeline _bindless_sprite_pipeline;
 			CmdManager _cmd;
 			RenderPass _pass;
 			Surface _surface;
@@ -133,8 +159,15 @@ namespace mlx
 
 			std::unique_ptr<UBO> _uniform_buffer;
 
+			SpriteBatch _sprite_batch;
+			ReadbackQueue _readbacks;
+			FrameTimestamps _timestamps;
+			FrameArena _frame_arena;
+			FrameCounters _counters;
+
 			class MLX_Window* _window = nullptr;
 			class Texture* _render_target = nullptr;
+			GraphicPipeline* _bound_pipeline = nullptr;
 
 			std::uint32_t _current_frame_index = 0;
 			std::uint32_t _image_index = 0;
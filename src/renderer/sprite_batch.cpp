@@ -0,0 +1,189 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sprite_batch.cpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 22:55:15 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:34:21 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <renderer/sprite_batch.h>
+#include <renderer/renderer.h>
+#include <renderer/images/texture.h>
+#include <core/profiler.h>
+#include <algorithm>
+#include <string>
+
+namespace mlx
+{
+	void SpriteBatch::newFrame(std::uint32_t frame_index) noexcept
+	{
+		_frame_index = frame_index;
+		_written_quads = 0;
+		_sprites.clear();
+	}
+
+	void SpriteBatch::push(Texture* texture, int x, int y)
+	{
+		_sprites.push_back({ texture, x, y, static_cast<int>(texture->getWidth()), static_cast<int>(texture->getHeight()) });
+	}
+
+	SpriteBatch::Chunk& SpriteBatch::getChunk(std::uint32_t index)
+	{
+		auto& chunks = _chunks[_frame_index];
+		while(chunks.size() <= index)
+		{
+			Chunk& chunk = chunks.emplace_back();
+			#ifdef DEBUG
+				std::string name = "__mlx_sprite_batch_chunk_" + std::to_string(_frame_index) + "_" + std::to_string(chunks.size() - 1);
+				chunk.buffer.create(Buffer::kind::dynamic, sizeof(SpriteInstance) * QUADS_PER_CHUNK, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, name.c_str());
+			#else
+				chunk.buffer.create(Buffer::kind::dynamic, sizeof(SpriteInstance) * QUADS_PER_CHUNK, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, nullptr);
+			#endif
+			chunk.buffer.mapMem(&chunk.map);
+		}
+		return chunks[index];
+	}
+
+	void SpriteBatch::buildBatches()
+	{
+		MLX_PROFILE_FUNCTION();
+		_batches.clear();
+		_next_sprite.assign(_sprites.size(), UINT32_MAX);
+		for(std::uint32_t i = 0; i < _sprites.size(); i++)
+		{
+			const Sprite& sprite = _sprites[i];
+			int min_x = sprite.x;
+			int min_y = sprite.y;
+			int max_x = sprite.x + sprite.w;
+			int max_y = sprite.y + sprite.h;
+
+			// looking for a previous batch with the same texture that can be reached without jumping over an overlapping batch
+			Batch* target = nullptr;
+			std::uint32_t lookback = 0;
+			for(auto it = _batches.rbegin(); it != _batches.rend() && lookback < BATCH_LOOKBACK; ++it, lookback++)
+			{
+				if(it->texture == sprite.texture)
+				{
+					target = &*it;
+					break;
+				}
+				if(min_x < it->max_x && it->min_x < max_x && min_y < it->max_y && it->min_y < max_y)
+					break;
+			}
+
+			if(target == nullptr)
+			{
+				_batches.push_back({ sprite.texture, min_x, min_y, max_x, max_y, i, i, 1 });
+				continue;
+			}
+			target->min_x = std::min(target->min_x, min_x);
+			target->min_y = std::min(target->min_y, min_y);
+			target->max_x = std::max(target->max_x, max_x);
+			target->max_y = std::max(target->max_y, max_y);
+			_next_sprite[target->last] = i;
+			target->last = i;
+			target->count++;
+		}
+	}
+
+	void SpriteBatch::flush(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer, GPUTimeCategory category)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_sprites.empty())
+			return;
+
+		buildBatches();
+
+		CmdBuffer& cmd = renderer.getActiveCmdBuffer();
+		Renderer::FrameCounters& counters = renderer.getFrameCounters();
+		renderer.getTimestamps().mark(cmd, category);
+
+		// with descriptor indexing the textures are picked from the texture table by a push constant,
+		// the per texture sets remain for devices without it and for textures that do not fit in the table
+		TextureTable& table = Render_Core::get().getTextureTable();
+		std::array<VkDescriptorSet, 2> table_sets = { sets[0], table.getSet() };
+		bool table_bound = false;
+
+		std::uint32_t bound_chunk = UINT32_MAX;
+		VkDescriptorSet bound_set = VK_NULL_HANDLE;
+		for(const Batch& batch : _batches)
+		{
+			std::uint32_t table_index = (table.isEnabled() ? batch.texture->prepareTableIndex() : TextureTable::INVALID_INDEX);
+			if(table_index != TextureTable::INVALID_INDEX)
+			{
+				GraphicPipeline& pipeline = renderer.getBindlessSpritePipeline();
+				renderer.bindPipeline(pipeline);
+				if(!table_bound)
+				{
+					vkCmdBindDescriptorSets(cmd.get(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.getPipelineLayout(), 0, table_sets.size(), table_sets.data(), 0, nullptr);
+					counters.descriptor_binds++;
+					table_bound = true;
+					bound_set = VK_NULL_HANDLE; // the layouts differ, switching back needs a full rebind
+				}
+				vkCmdPushConstants(cmd.get(), pipeline.getPipelineLayout(), VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(std::uint32_t), &table_index);
+			}
+			else
+			{
+				renderer.bindPipeline(renderer.getSpritePipeline());
+				VkDescriptorSet set = batch.texture->prepareSet(renderer);
+				if(set != bound_set)
+				{
+					sets[1] = set;
+					vkCmdBindDescriptorSets(cmd.get(), VK_PIPELINE_BIND_POINT_GRAPHICS, renderer.getSpritePipeline().getPipelineLayout(), 0, sets.size(), sets.data(), 0, nullptr);
+					counters.descriptor_binds++;
+					bound_set = set;
+					table_bound = false;
+				}
+			}
+
+			std::uint32_t sprite_index = batch.first;
+			std::uint32_t remaining = batch.count;
+			while(remaining > 0)
+			{
+				std::uint32_t chunk_index = _written_quads / QUADS_PER_CHUNK;
+				std::uint32_t first_quad = _written_quads % QUADS_PER_CHUNK;
+				std::uint32_t quads = std::min(remaining, QUADS_PER_CHUNK - first_quad);
+				Chunk& chunk = getChunk(chunk_index);
+
+				SpriteInstance* instances = static_cast<SpriteInstance*>(chunk.map) + first_quad;
+				for(std::uint32_t q = 0; q < quads; q++, sprite_index = _next_sprite[sprite_index])
+				{
+					const Sprite& sprite = _sprites[sprite_index];
+					instances->pos = glm::vec2(sprite.x, sprite.y);
+					instances->size = glm::vec2(sprite.w, sprite.h);
+					instances->uv = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+					instances->color = glm::vec4(1.0f);
+					instances++;
+				}
+				chunk.buffer.flush(sizeof(SpriteInstance) * quads, sizeof(SpriteInstance) * first_quad);
+
+				if(bound_chunk != chunk_index)
+				{
+					cmd.bindVertexBuffer(chunk.buffer);
+					bound_chunk = chunk_index;
+				}
+				vkCmdDraw(cmd.get(), 4, quads, 0, first_quad);
+				counters.draw_calls++;
+
+				_written_quads += quads;
+				remaining -= quads;
+			}
+		}
+		_sprites.clear();
+	}
+
+	void SpriteBatch::destroy() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		for(auto& chunks : _chunks)
+		{
+			for(Chunk& chunk : chunks)
+				chunk.buffer.destroy();
+			chunks.clear();
+		}
+	}
+}
@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sprite_batch.h                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 22:54:58 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/17 00:34:21 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_SPRITE_BATCH__
+#define __MLX_SPRITE_BATCH__
+
+#include <mlx_profile.h>
+#include <volk.h>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <renderer/core/render_core.h>
+#include <renderer/buffers/vk_buffer.h>
+#include <renderer/frame_timestamps.h>
+
+namespace mlx
+{
+	struct SpriteInstance
+	{
+		glm::vec2 pos;
+		glm::vec2 size;
+		glm::vec4 uv = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); // offset in xy and size in zw, the full texture by default
+		glm::vec4 color = glm::vec4(1.0f); // tint
+
+		static VkVertexInputBindingDescription getBindingDescription()
+		{
+			VkVertexInputBindingDescription bindingDescription{};
+			bindingDescription.binding = 0;
+			bindingDescription.stride = sizeof(SpriteInstance);
+			bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+			return bindingDescription;
+		}
+
+		static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions()
+		{
+			std::array<VkVertexInputAttributeDescription, 4> attributeDescriptions;
+
+			attributeDescriptions[0].binding = 0;
+			attributeDescriptions[0].location = 0;
+			attributeDescriptions[0].format = VK_FORMAT_R32G32_SFLOAT;
+			attributeDescriptions[0].offset = offsetof(SpriteInstance, pos);
+
+			attributeDescriptions[1].binding = 0;
+			attributeDescriptions[1].location = 1;
+			attributeDescriptions[1].format = VK_FORMAT_R32G32_SFLOAT;
+			attributeDescriptions[1].offset = offsetof(SpriteInstance, size);
+
+			attributeDescriptions[2].binding = 0;
+			attributeDescriptions[2].location = 2;
+			attributeDescriptions[2].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+			attributeDescriptions[2].offset = offsetof(SpriteInstance, uv);
+
+			attributeDescriptions[3].binding = 0;
+			attributeDescriptions[3].location = 3;
+			attributeDescriptions[3].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+			attributeDescriptions[3].offset = offsetof(SpriteInstance, color);
+
+			return attributeDescriptions;
+		}
+	};
+
+	/**
+	 * Collects the textured quads of a frame and draws them with as few draw
+	 * calls and descriptor bindings as possible.
+	 * Each quad is an instance (position, size, UV rect and tint) written in a persistently
+	 * mapped instance ring (one per frame in flight), and consecutive quads
+	 * sharing a texture are drawn by a single instanced draw. A quad may be moved back to an earlier batch using the same texture
+	 * if it does not overlap anything drawn in between, which keeps the result
+	 * identical to drawing in painter's order.
+	 * When the texture table is enabled the batches only push the index of
+	 * their texture, otherwise each texture binds its own descriptor set.
+	 */
+	class SpriteBatch
+	{
+		public:
+			static constexpr std::uint32_t QUADS_PER_CHUNK = 4096;
+			static constexpr std::uint32_t BATCH_LOOKBACK = 32;
+
+		public:
+			SpriteBatch() = default;
+
+			void newFrame(std::uint32_t frame_index) noexcept;
+			void push(class Texture* texture, int x, int y);
+			void flush(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer, GPUTimeCategory category = GPUTimeCategory::images);
+			void destroy() noexcept;
+
+			~SpriteBatch() = default;
+
+		private:
+			struct Sprite
+			{
+				class Texture* texture;
+				int x;
+				int y;
+				int w;
+				int h;
+			};
+
+			struct Batch
+			{
+				class Texture* texture;
+				int min_x;
+				int min_y;
+				int max_x;
+				int max_y;
+				std::uint32_t first;
+				std::uint32_t last;
+				std::uint32_t count;
+			};
+
+			struct Chunk
+			{
+				Buffer buffer;
+				void* map = nullptr;
+			};
+
+		private:
+			void buildBatches();
+			Chunk& getChunk(std::uint32_t index);
+
+		private:
+			std::array<std::vector<Chunk>, MAX_FRAMES_IN_FLIGHT> _chunks;
+			std::vector<Sprite> _sprites;
+			std::vector<Batch> _batches;
+			std::vector<std::uint32_t> _next_sprite; // intrusive lists of the sprites of each batch
+			std::uint32_t _frame_index = 0;
+			std::uint32_t _written_quads = 0;
+	};
+}
+
+#endif
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:22:28 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:08:19 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:37:00 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -29,7 +29,9 @@ namespace mlx
 		VkPresentModeKHR presentMode = chooseSwapPresentMode(_swapchain_support.present_modes);
 		_extent = chooseSwapExtent(_swapchain_support.capabilities);
 
-		std::uint32_t imageCount = _swapchain_support.capabilities.minImageCount + 1;
+		std::uint32_t imageCount = (_image_count_hint != 0 ? _image_count_hint : _swapchain_support.capabilities.minImageCount + 1);
+		if(imageCount < _swapchain_support.capabilities.minImageCount)
+			imageCount = _swapchain_support.capabilities.minImageCount;
 		if(_swapchain_support.capabilities.maxImageCount > 0 && imageCount > _swapchain_support.capabilities.maxImageCount)
 			imageCount = _swapchain_support.capabilities.maxImageCount;
 
@@ -45,6 +47,9 @@ namespace mlx
 		createInfo.imageExtent = _extent;
 		createInfo.imageArrayLayers = 1;
 		createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		if(_swapchain_support.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+			createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT; // needed by window readbacks
+		_readable = (createInfo.imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
 		createInfo.preTransform = _swapchain_support.capabilities.currentTransform;
 		createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 		createInfo.presentMode = presentMode;
@@ -77,6 +82,7 @@ namespace mlx
 		}
 
 		_swapchain_image_format = surfaceFormat.format;
+		_present_mode = presentMode;
 		#ifdef DEBUG
 			core::error::report(e_kind::message, "Vulkan : created new swapchain");
 		#endif
@@ -111,10 +117,22 @@ namespace mlx
 		return details;
 	}
 
-	VkPresentModeKHR SwapChain::chooseSwapPresentMode([[maybe_unused]] const std::vector<VkPresentModeKHR>& availablePresentModes)
+	VkPresentModeKHR SwapChain::chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
 	{
-		// in the future, you may choose to activate vsync or not
-		return VK_PRESENT_MODE_IMMEDIATE_KHR;
+		auto is_available = [&](VkPresentModeKHR mode) { return std::find(availablePresentModes.begin(), availablePresentModes.end(), mode) != availablePresentModes.end(); };
+		if(is_available(_requested_present_mode))
+			return _requested_present_mode;
+
+		// falls back on the closest mode, low latency ones first stay low latency, FIFO is always supported
+		VkPresentModeKHR fallback = VK_PRESENT_MODE_FIFO_KHR;
+		if(_requested_present_mode == VK_PRESENT_MODE_IMMEDIATE_KHR && is_available(VK_PRESENT_MODE_MAILBOX_KHR))
+			fallback = VK_PRESENT_MODE_MAILBOX_KHR;
+		else if(_requested_present_mode == VK_PRESENT_MODE_MAILBOX_KHR && is_available(VK_PRESENT_MODE_IMMEDIATE_KHR))
+			fallback = VK_PRESENT_MODE_IMMEDIATE_KHR;
+		if(_reported_present_mode != _requested_present_mode) // once per request, not on every resize
+			core::error::report(e_kind::warning, "Vulkan : requested present mode is not supported, falling back on %s", fallback == VK_PRESENT_MODE_FIFO_KHR ? "FIFO" : (fallback == VK_PRESENT_MODE_MAILBOX_KHR ? "mailbox" : "immediate"));
+		_reported_present_mode = _requested_present_mode;
+		return fallback;
 	}
 
 	VkExtent2D SwapChain::chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities)
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:23:27 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:06:41 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:37:00 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -43,7 +43,11 @@ namespace mlx
 
 			SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
 			VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities);
-			VkPresentModeKHR chooseSwapPresentMode([[maybe_unused]] const std::vector<VkPresentModeKHR> &availablePresentModes);
+			VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);
+
+			// both are applied by the next recreation of the swapchain
+			inline void setPresentMode(VkPresentModeKHR mode) noexcept { _requested_present_mode = mode; }
+			inline void setImageCountHint(std::uint32_t count) noexcept { _image_count_hint = count; }
 
 			inline VkSwapchainKHR get() noexcept { return _swapchain; }
 			inline VkSwapchainKHR operator()() noexcept { return _swapchain; }
@@ -52,6 +56,9 @@ namespace mlx
 			inline SwapChainSupportDetails getSupport() noexcept { return _swapchain_support; }
 			inline VkExtent2D getExtent() noexcept { return _extent; }
 			inline VkFormat getImagesFormat() const noexcept { return _swapchain_image_format; }
+			inline bool isReadable() const noexcept { return _readable; }
+			inline VkPresentModeKHR getPresentMode() const noexcept { return _present_mode; }
+			inline VkPresentModeKHR getRequestedPresentMode() const noexcept { return _requested_present_mode; }
 
 			~SwapChain() = default;
 
@@ -62,6 +69,11 @@ namespace mlx
 			VkFormat _swapchain_image_format;
 			VkExtent2D _extent;
 			class Renderer* _renderer = nullptr;
+			VkPresentModeKHR _requested_present_mode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+			VkPresentModeKHR _present_mode = VK_PRESENT_MODE_FIFO_KHR;
+			VkPresentModeKHR _reported_present_mode = VK_PRESENT_MODE_MAX_ENUM_KHR;
+			std::uint32_t _image_count_hint = 0; // 0 lets the swapchain pick
+			bool _readable = false;
 	};
 }
 
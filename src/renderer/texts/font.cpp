@@ -6,14 +6,14 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/12/11 22:06:09 by kbz_8             #+#    #+#             */
-/*   Updated: 2024/01/18 13:16:18 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:16:24 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <renderer/texts/font.h>
 #include <renderer/renderer.h>
 #include <core/profiler.h>
-#include <fstream>
+#include <platform/mapped_file.h>
 
 constexpr const int RANGE = 1024;
 
@@ -24,38 +24,33 @@ namespace mlx
 		_build_data = path;
 	}
 
-	Font::Font(class Renderer& renderer, const std::string& name, const std::vector<std::uint8_t>& ttf_data, float scale) : _name(name), _renderer(renderer), _scale(scale)
+	Font::Font(class Renderer& renderer, const std::string& name, std::vector<std::uint8_t> ttf_data, float scale) : _name(name), _renderer(renderer), _scale(scale)
 	{
-		_build_data = ttf_data;
+		_build_data = std::move(ttf_data);
 	}
 
 	void Font::buildFont()
 	{
 		MLX_PROFILE_FUNCTION();
-		std::vector<std::uint8_t> file_bytes;
+		MappedFile file; // the font is read straight from the mapping, stb truetype only needs it while packing
+		const std::uint8_t* ttf_data = nullptr;
 		if(std::holds_alternative<std::filesystem::path>(_build_data))
 		{
-			std::ifstream file(std::get<std::filesystem::path>(_build_data), std::ios::binary);
-			if(!file.is_open())
+			if(!file.open(std::get<std::filesystem::path>(_build_data)))
 			{
 				core::error::report(e_kind::error, "Font load : cannot open font file, %s", _name.c_str());
 				return;
 			}
-			std::ifstream::pos_type fileSize = std::filesystem::file_size(std::get<std::filesystem::path>(_build_data));
-			file.seekg(0, std::ios::beg);
-			file_bytes.resize(fileSize);
-			file.read(reinterpret_cast<char*>(file_bytes.data()), fileSize);
-			file.close();
+			ttf_data = file.data();
 		}
+		else
+			ttf_data = std::get<std::vector<std::uint8_t>>(_build_data).data();
 
 		std::vector<std::uint8_t> tmp_bitmap(RANGE * RANGE);
 		std::vector<std::uint8_t> vulkan_bitmap(RANGE * RANGE * 4);
 		stbtt_pack_context pc;
 		stbtt_PackBegin(&pc, tmp_bitmap.data(), RANGE, RANGE, RANGE, 1, nullptr);
-		if(std::holds_alternative<std::filesystem::path>(_build_data))
-			stbtt_PackFontRange(&pc, file_bytes.data(), 0, _scale, 32, 96, _cdata.data());
-		else
-			stbtt_PackFontRange(&pc, std::get<std::vector<std::uint8_t>>(_build_data).data(), 0, _scale, 32, 96, _cdata.data());
+		stbtt_PackFontRange(&pc, ttf_data, 0, _scale, 32, 96, _cdata.data());
 		stbtt_PackEnd(&pc);
 		for(int i = 0, j = 0; i < RANGE * RANGE; i++, j += 4)
 		{
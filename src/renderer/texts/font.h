@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/12/11 21:17:04 by kbz_8             #+#    #+#             */
-/*   Updated: 2024/01/18 13:15:55 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:16:24 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -27,7 +27,7 @@ namespace mlx
 		public:
 			Font() = delete;
 			Font(class Renderer& renderer, const std::filesystem::path& path, float scale);
-			Font(class Renderer& renderer, const std::string& name, const std::vector<std::uint8_t>& ttf_data, float scale);
+			Font(class Renderer& renderer, const std::string& name, std::vector<std::uint8_t> ttf_data, float scale);
 
 			inline const std::string& getName() const { return _name; }
 			inline float getScale() const noexcept { return _scale; }
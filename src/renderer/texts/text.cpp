@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/11 00:11:56 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:13:08 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,7 +16,7 @@
 
 namespace mlx
 {
-	void Text::init(std::string text, FontID font, std::uint32_t color, std::vector<Vertex> vbo_data, std::vector<std::uint16_t> ibo_data)
+	void Text::init(std::string text, FontID font, std::uint32_t color, const Vertex* vertices, std::size_t vertex_count, const std::uint16_t* indices, std::size_t index_count)
 	{
 		MLX_PROFILE_FUNCTION();
 		if(_is_init)
@@ -32,12 +32,12 @@ namespace mlx
 					c = '_';
 			}
 			for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-				_vbo[i].create(sizeof(Vertex) * vbo_data.size(), static_cast<const void*>(vbo_data.data()), debug_name.c_str());
-			_ibo.create(sizeof(std::uint16_t) * ibo_data.size(), ibo_data.data(), debug_name.c_str());
+				_vbo[i].create(sizeof(Vertex) * vertex_count, static_cast<const void*>(vertices), debug_name.c_str());
+			_ibo.create(sizeof(std::uint16_t) * index_count, indices, debug_name.c_str());
 		#else
 			for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-				_vbo[i].create(sizeof(Vertex) * vbo_data.size(), static_cast<const void*>(vbo_data.data()), nullptr);
-			_ibo.create(sizeof(std::uint16_t) * ibo_data.size(), ibo_data.data(), nullptr);
+				_vbo[i].create(sizeof(Vertex) * vertex_count, static_cast<const void*>(vertices), nullptr);
+			_ibo.create(sizeof(std::uint16_t) * index_count, indices, nullptr);
 		#endif
 		_is_init = true;
 	}
@@ -51,12 +51,12 @@ namespace mlx
 		_ibo.bind(renderer);
 	}
 
-	void Text::updateVertexData(int frame, std::vector<Vertex> vbo_data)
+	void Text::updateVertexData(int frame, const Vertex* vertices, std::size_t count)
 	{
 		MLX_PROFILE_FUNCTION();
 		if(!_is_init)
 			return;
-		_vbo[frame].setData(sizeof(Vertex) * vbo_data.size(), static_cast<const void*>(vbo_data.data()));
+		_vbo[frame].setData(sizeof(Vertex) * count, static_cast<const void*>(vertices));
 	}
 
 	void Text::destroy() noexcept
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/11 00:09:04 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:16:48 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -27,10 +27,10 @@ namespace mlx
 		public:
 			Text() = default;
 
-			void init(std::string text, FontID font, std::uint32_t color, std::vector<Vertex> vbo_data, std::vector<std::uint16_t> ibo_data);
+			void init(std::string text, FontID font, std::uint32_t color, const Vertex* vertices, std::size_t vertex_count, const std::uint16_t* indices, std::size_t index_count);
 			void bind(class Renderer& renderer) noexcept;
 			inline FontID getFontInUse() const noexcept { return _font; }
-			void updateVertexData(int frame, std::vector<Vertex> vbo_data);
+			void updateVertexData(int frame, const Vertex* vertices, std::size_t count);
 			inline std::uint32_t getIBOsize() noexcept { return _ibo.getSize(); }
 			inline const std::string& getText() const { return _text; }
 			inline std::uint32_t getColor() const noexcept { return _color; }
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/11 00:23:11 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:13:48 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:10:27 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,6 +15,7 @@
 #include <renderer/images/texture_atlas.h>
 #include <renderer/texts/font.h>
 #include <renderer/texts/text.h>
+#include <renderer/frame_arena.h>
 
 #define STB_RECT_PACK_IMPLEMENTATION
 #include <stb_rect_pack.h>
@@ -33,11 +34,33 @@ namespace mlx
 	TextDrawDescriptor::TextDrawDescriptor(std::string text, std::uint32_t _color, int _x, int _y) : color(_color), x(_x), y(_y), _text(std::move(text))
 	{}
 
-	void TextDrawDescriptor::init(FontID font) noexcept
+	void TextDrawDescriptor::set(std::string_view text, std::uint32_t _color, int _x, int _y)
+	{
+		_text.assign(text.data(), text.size()); // keeps the capacity of the string
+		color = _color;
+		x = _x;
+		y = _y;
+	}
+
+	void TextDrawDescriptor::init(FontID font, FrameArena& arena) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		std::vector<Vertex> vertexData;
-		std::vector<std::uint16_t> indexData;
+		// the same text may already have been built for another position
+		id = TextLibrary::get().findText(_text, color, font);
+		if(id != nulltext)
+			return;
+
+		std::size_t quads = 0;
+		for(char c : _text)
+		{
+			if(c >= 32)
+				quads++;
+		}
+		// the vertices only live until they are copied into the text buffers
+		Vertex* vertexData = arena.allocate<Vertex>(quads * 4);
+		std::uint16_t* indexData = arena.allocate<std::uint16_t>(quads * 6);
+		std::size_t vertex_count = 0;
+		std::size_t index_count = 0;
 
 		float stb_x = 0.0f;
 		float stb_y = 0.0f;
@@ -53,7 +76,7 @@ namespace mlx
 				stbtt_aligned_quad q;
 				stbtt_GetPackedQuad(font_data->getCharData().data(), RANGE, RANGE, c - 32, &stb_x, &stb_y, &q, 1);
 
-				std::size_t index = vertexData.size();
+				std::size_t index = vertex_count;
 
 				glm::vec4 vertex_color = {
 					static_cast<float>((color & 0x000000FF)) / 255.f,
@@ -62,21 +85,21 @@ namespace mlx
 					static_cast<float>((color & 0xFF000000) >> 24) / 255.f
 				};
 
-				vertexData.emplace_back(glm::vec2{q.x0, q.y0}, vertex_color, glm::vec2{q.s0, q.t0});
-				vertexData.emplace_back(glm::vec2{q.x1, q.y0}, vertex_color, glm::vec2{q.s1, q.t0});
-				vertexData.emplace_back(glm::vec2{q.x1, q.y1}, vertex_color, glm::vec2{q.s1, q.t1});
-				vertexData.emplace_back(glm::vec2{q.x0, q.y1}, vertex_color, glm::vec2{q.s0, q.t1});
-
-				indexData.emplace_back(index + 0);
-				indexData.emplace_back(index + 1);
-				indexData.emplace_back(index + 2);
-				indexData.emplace_back(index + 2);
-				indexData.emplace_back(index + 3);
-				indexData.emplace_back(index + 0);
+				new (&vertexData[vertex_count++]) Vertex(glm::vec2{q.x0, q.y0}, vertex_color, glm::vec2{q.s0, q.t0});
+				new (&vertexData[vertex_count++]) Vertex(glm::vec2{q.x1, q.y0}, vertex_color, glm::vec2{q.s1, q.t0});
+				new (&vertexData[vertex_count++]) Vertex(glm::vec2{q.x1, q.y1}, vertex_color, glm::vec2{q.s1, q.t1});
+				new (&vertexData[vertex_count++]) Vertex(glm::vec2{q.x0, q.y1}, vertex_color, glm::vec2{q.s0, q.t1});
+
+				indexData[index_count++] = index + 0;
+				indexData[index_count++] = index + 1;
+				indexData[index_count++] = index + 2;
+				indexData[index_count++] = index + 2;
+				indexData[index_count++] = index + 3;
+				indexData[index_count++] = index + 0;
 			}
 		}
 		std::shared_ptr<Text> text_data = std::make_shared<Text>();
-		text_data->init(_text, font, color, std::move(vertexData), std::move(indexData));
+		text_data->init(_text, font, color, vertexData, vertex_count, indexData, index_count);
 		id = TextLibrary::get().addTextToLibrary(text_data);
 
 		#ifdef DEBUG
@@ -87,6 +110,9 @@ namespace mlx
 	void TextDrawDescriptor::render(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer)
 	{
 		MLX_PROFILE_FUNCTION();
+		renderer.getSpriteBatch().flush(sets, renderer); // sprites put before this text have to be drawn first
+		renderer.getTimestamps().mark(renderer.getActiveCmdBuffer(), GPUTimeCategory::texts);
+		renderer.bindPipeline(renderer.getPipeline());
 		std::shared_ptr<Text> draw_data = TextLibrary::get().getTextData(id);
 		std::shared_ptr<Font> font_data = FontLibrary::get().getFontData(draw_data->getFontInUse());
 		TextureAtlas& atlas = const_cast<TextureAtlas&>(font_data->getAtlas());
@@ -98,13 +124,7 @@ namespace mlx
 		sets[1] = const_cast<TextureAtlas&>(atlas).getVkSet();
 		vkCmdBindDescriptorSets(renderer.getActiveCmdBuffer().get(), VK_PIPELINE_BIND_POINT_GRAPHICS, renderer.getPipeline().getPipelineLayout(), 0, sets.size(), sets.data(), 0, nullptr);
 		atlas.render(renderer, x, y, draw_data->getIBOsize());
-	}
-
-	void TextDrawDescriptor::resetUpdate()
-	{
-		std::shared_ptr<Text> draw_data = TextLibrary::get().getTextData(id);
-		std::shared_ptr<Font> font_data = FontLibrary::get().getFontData(draw_data->getFontInUse());
-		TextureAtlas& atlas = const_cast<TextureAtlas&>(font_data->getAtlas());
-		atlas.resetUpdate();
+		renderer.getFrameCounters().descriptor_binds++;
+		renderer.getFrameCounters().draw_calls++;
 	}
 }
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/11 00:13:34 by maldavid          #+#    #+#             */
-/*   Updated: 2024/02/25 07:58:13 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,22 +14,24 @@
 #define __MLX_TEXT_DESCRIPTOR__
 
 #include <string>
+#include <string_view>
 #include <mlx_profile.h>
 #include <volk.h>
 #include <utils/combine_hash.h>
-#include <renderer/core/drawable_resource.h>
 #include <renderer/texts/text_library.h>
 #include <renderer/texts/font_library.h>
 #include <array>
 
 namespace mlx
 {
-	class TextDrawDescriptor : public DrawableResource
+	class TextDrawDescriptor
 	{
 		friend class std::hash<TextDrawDescriptor>;
 
 		public:
 			TextID id;
+			std::uint32_t index = 0; // position in the text manager's draw table
+			std::uint64_t generation = 0; // text manager clear during which the text was last put
 			std::uint32_t color;
 			int x;
 			int y;
@@ -37,10 +39,10 @@ namespace mlx
 		public:
 			TextDrawDescriptor(std::string text, std::uint32_t _color, int _x, int _y);
 
-			void init(FontID font) noexcept;
+			void set(std::string_view text, std::uint32_t _color, int _x, int _y);
+			void init(FontID font, class FrameArena& arena) noexcept;
 			bool operator==(const TextDrawDescriptor& rhs) const { return _text == rhs._text && x == rhs.x && y == rhs.y && color == rhs.color; }
-			void render(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer) override;
-			void resetUpdate() override;
+			void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer);
 
 			TextDrawDescriptor() = default;
 
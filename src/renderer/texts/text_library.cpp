@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/10 11:59:57 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:17:06 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:34:54 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,7 +14,6 @@
 #include <renderer/texts/text.h>
 #include <core/errors.h>
 #include <renderer/renderer.h>
-#include <algorithm>
 #include <core/profiler.h>
 
 namespace mlx
@@ -30,17 +29,32 @@ namespace mlx
 	TextID TextLibrary::addTextToLibrary(std::shared_ptr<Text> text)
 	{
 		MLX_PROFILE_FUNCTION();
-		auto it = std::find_if(_cache.begin(), _cache.end(), [&](const std::pair<TextID, std::shared_ptr<Text>>& v)
-		{
-			return v.second->getText() == text->getText() && v.second->getColor() == text->getColor();
-		});
-		if(it != _cache.end())
-			return it->first;
+		_lookup.emplace(hashText(text->getText(), text->getColor(), text->getFontInUse()), _current_id);
 		_cache[_current_id] = text;
 		_current_id++;
 		return _current_id - 1;
 	}
 
+	std::size_t TextLibrary::hashText(std::string_view text, std::uint32_t color, FontID font) noexcept
+	{
+		std::size_t hash = 0;
+		hashCombine(hash, text, color, font);
+		return hash;
+	}
+
+	TextID TextLibrary::findText(std::string_view text, std::uint32_t color, FontID font) const
+	{
+		MLX_PROFILE_FUNCTION();
+		auto [begin, end] = _lookup.equal_range(hashText(text, color, font));
+		for(auto it = begin; it != end; ++it)
+		{
+			const Text& candidate = *_cache.at(it->second);
+			if(candidate.getText() == text && candidate.getColor() == color && candidate.getFontInUse() == font)
+				return it->second;
+		}
+		return nulltext;
+	}
+
 	void TextLibrary::removeTextFromLibrary(TextID id)
 	{
 		MLX_PROFILE_FUNCTION();
@@ -49,6 +63,16 @@ namespace mlx
 			core::error::report(e_kind::warning, "Text Library : trying to remove a text with an unkown or invalid ID '%d'", id);
 			return;
 		}
+		const Text& text = *_cache[id];
+		auto [begin, end] = _lookup.equal_range(hashText(text.getText(), text.getColor(), text.getFontInUse()));
+		for(auto it = begin; it != end; ++it)
+		{
+			if(it->second == id)
+			{
+				_lookup.erase(it);
+				break;
+			}
+		}
 		_cache[id]->destroy();
 		_cache.erase(id);
 	}
@@ -59,5 +83,6 @@ namespace mlx
 		for(auto& [id, text] : _cache)
 			text->destroy();
 		_cache.clear();
+		_lookup.clear();
 	}
 }
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/10 11:52:30 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:04:47 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/17 00:34:54 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,11 +17,14 @@
 #include <renderer/buffers/vk_ibo.h>
 #include <unordered_map>
 #include <memory>
+#include <string_view>
 #include <cstdint>
 #include <mlx_profile.h>
 #include <renderer/texts/font.h>
+#include <renderer/texts/font_library.h>
 #include <renderer/core/render_core.h>
 #include <utils/singleton.h>
+#include <utils/combine_hash.h>
 
 namespace mlx
 {
@@ -34,7 +37,8 @@ namespace mlx
 
 		public:
 			std::shared_ptr<class Text> getTextData(TextID id);
-			TextID addTextToLibrary(std::shared_ptr<Text> text);
+			TextID addTextToLibrary(std::shared_ptr<Text> text); // the text must not be in the library yet, see findText
+			TextID findText(std::string_view text, std::uint32_t color, FontID font) const;
 			void removeTextFromLibrary(TextID id);
 
 			void clearLibrary();
@@ -43,8 +47,11 @@ namespace mlx
 			TextLibrary() = default;
 			~TextLibrary() = default;
 
+			static std::size_t hashText(std::string_view text, std::uint32_t color, FontID font) noexcept;
+
 		private:
 			std::unordered_map<TextID, std::shared_ptr<class Text>> _cache;
+			std::unordered_multimap<std::size_t, TextID> _lookup; // hash of the text, color and font to the texts sharing it
 			TextID _current_id = 1;
 	};
 }
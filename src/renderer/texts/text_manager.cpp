@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/06 16:41:13 by maldavid          #+#    #+#             */
-/*   Updated: 2024/02/25 09:29:36 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,12 +17,14 @@
 #include <core/profiler.h>
 
 #include <utils/dogica_ttf.h>
+#include <string_view>
 
 namespace mlx
 {
 	void TextManager::init(Renderer& renderer) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
+		_renderer = &renderer;
 		loadFont(renderer, "default", 6.f);
 	}
 
@@ -38,29 +40,59 @@ namespace mlx
 		_font_in_use = FontLibrary::get().addFontToLibrary(font);
 	}
 
-	std::pair<DrawableResource*, bool> TextManager::registerText(int x, int y, std::uint32_t color, std::string str)
+	void TextManager::loadFont(Renderer& renderer, const std::uint8_t* data, std::size_t size, float scale)
 	{
 		MLX_PROFILE_FUNCTION();
-		auto res = _text_descriptors.emplace(std::move(str), color, x, y);
-		if(res.second)
+		// fonts are told apart by name, the name of a memory font comes from its content
+		std::size_t hash = std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(data), size));
+		std::string name = "__mlx_memory_font_" + std::to_string(hash);
+		std::shared_ptr<Font> font = std::make_shared<Font>(renderer, name, std::vector<std::uint8_t>(data, data + size), scale);
+		_font_in_use = FontLibrary::get().addFontToLibrary(font);
+	}
+
+	std::uint32_t TextManager::registerText(int x, int y, std::uint32_t color, std::string_view str)
+	{
+		MLX_PROFILE_FUNCTION();
+		_probe.set(str, color, x, y);
+		auto it = _text_descriptors.find(_probe);
+		if(it == _text_descriptors.end())
 		{
-			const_cast<TextDrawDescriptor&>(*res.first).init(_font_in_use);
-			return std::make_pair(static_cast<DrawableResource*>(&const_cast<TextDrawDescriptor&>(*res.first)), true);
+			it = _text_descriptors.insert(_probe).first;
+			const_cast<TextDrawDescriptor&>(*it).init(_font_in_use, _renderer->getFrameArena());
+		}
+		TextDrawDescriptor& desc = const_cast<TextDrawDescriptor&>(*it);
+		if(desc.generation != _generation)
+		{
+			desc.generation = _generation;
+			desc.index = static_cast<std::uint32_t>(_texts.size());
+			_texts.push_back(&desc);
 		}
 
-		auto text_ptr = TextLibrary::get().getTextData(res.first->id);
+		auto text_ptr = TextLibrary::get().getTextData(desc.id);
 		if(_font_in_use != text_ptr->getFontInUse())
+			desc.init(_font_in_use, _renderer->getFrameArena()); // the text built with the previous font stays in the library for the others
+		return desc.index;
+	}
+
+	void TextManager::clear()
+	{
+		MLX_PROFILE_FUNCTION();
+		// the texts put since the last clear are kept so putting them again does not rebuild them
+		for(auto it = _text_descriptors.begin(); it != _text_descriptors.end();)
 		{
-			// TODO : update text vertex buffers rather than destroying it and recreating it
-			TextLibrary::get().removeTextFromLibrary(res.first->id);
-			const_cast<TextDrawDescriptor&>(*res.first).init(_font_in_use);
+			if(it->generation != _generation)
+				it = _text_descriptors.erase(it);
+			else
+				++it;
 		}
-		return std::make_pair(static_cast<DrawableResource*>(&const_cast<TextDrawDescriptor&>(*res.first)), false);
+		_texts.clear();
+		_generation++;
 	}
 
 	void TextManager::destroy() noexcept
 	{
 		MLX_PROFILE_FUNCTION();
 		_text_descriptors.clear();
+		_texts.clear();
 	}
 }
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/06 16:24:11 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:08:43 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,10 +16,13 @@
 #include <renderer/renderer.h>
 #include <renderer/images/texture_atlas.h>
 #include <string>
+#include <string_view>
 #include <stb_truetype.h>
 #include <cstdint>
 #include <unordered_set>
+#include <vector>
 #include <mlx_profile.h>
+#include <utils/pool_allocator.h>
 #include <renderer/texts/text_descriptor.h>
 #include <renderer/texts/text_library.h>
 #include <renderer/texts/font_library.h>
@@ -32,15 +35,21 @@ namespace mlx
 			TextManager() = default;
 
 			void init(Renderer& renderer) noexcept;
-			std::pair<DrawableResource*, bool> registerText(int x, int y, std::uint32_t color, std::string str);
-			inline void clear() { _text_descriptors.clear(); }
+			std::uint32_t registerText(int x, int y, std::uint32_t color, std::string_view str);
+			inline TextDrawDescriptor& getText(std::uint32_t index) noexcept { return *_texts[index]; }
+			void clear();
 			void loadFont(Renderer& renderer, const std::filesystem::path& filepath, float scale);
+			void loadFont(Renderer& renderer, const std::uint8_t* data, std::size_t size, float scale);
 			void destroy() noexcept;
 
 			~TextManager() = default;
 
 		private:
-			std::unordered_set<TextDrawDescriptor> _text_descriptors;
+			std::unordered_set<TextDrawDescriptor, std::hash<TextDrawDescriptor>, std::equal_to<TextDrawDescriptor>, PoolAllocator<TextDrawDescriptor>> _text_descriptors;
+			std::vector<TextDrawDescriptor*> _texts;
+			TextDrawDescriptor _probe; // lookup key, reused to not allocate a string on every put
+			Renderer* _renderer = nullptr;
+			std::uint64_t _generation = 1;
 			FontID _font_in_use = nullfont;
 	};
 }
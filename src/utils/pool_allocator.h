@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_allocator.h                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 23:39:46 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 23:44:05 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+#ifndef __MLX_POOL_ALLOCATOR__
+#define __MLX_POOL_ALLOCATOR__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mlx
+{
+	/**
+	 * Free list of fixed size blocks carved out of chunks that are never given
+	 * back to the heap. Not thread safe, the pools are only used by the main thread.
+	 */
+	template <std::size_t Size, std::size_t Alignment>
+	class NodePool
+	{
+		public:
+			static constexpr std::size_t NODES_PER_CHUNK = 256;
+
+		public:
+			inline static NodePool& get()
+			{
+				static NodePool pool;
+				return pool;
+			}
+
+			inline void* allocate()
+			{
+				if(_free == nullptr)
+					grow();
+				Node* node = _free;
+				_free = node->next;
+				return node;
+			}
+
+			inline void deallocate(void* ptr) noexcept
+			{
+				Node* node = static_cast<Node*>(ptr);
+				node->next = _free;
+				_free = node;
+			}
+
+		private:
+			union Node
+			{
+				Node* next;
+				alignas(Alignment) std::byte storage[Size];
+			};
+
+		private:
+			NodePool() = default;
+
+			inline void grow()
+			{
+				Node* chunk = _chunks.emplace_back(std::make_unique<Node[]>(NODES_PER_CHUNK)).get();
+				for(std::size_t i = 0; i < NODES_PER_CHUNK; i++)
+					deallocate(&chunk[i]);
+			}
+
+		private:
+			std::vector<std::unique_ptr<Node[]>> _chunks;
+			Node* _free = nullptr;
+	};
+
+	/**
+	 * Allocator for node based containers that are cleared and filled again
+	 * every frame: single nodes go back to a pool shared by every container of
+	 * the same node size instead of the heap, arrays (buckets) use the heap.
+	 */
+	template <typename T>
+	class PoolAllocator
+	{
+		public:
+			using value_type = T;
+
+		public:
+			PoolAllocator() noexcept = default;
+			template <typename U>
+			PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+			inline T* allocate(std::size_t n)
+			{
+				if(n == 1)
+					return static_cast<T*>(NodePool<sizeof(T), alignof(T)>::get().allocate());
+				return std::allocator<T>{}.allocate(n);
+			}
+
+			inline void deallocate(T* ptr, std::size_t n) noexcept
+			{
+				if(n == 1)
+					NodePool<sizeof(T), alignof(T)>::get().deallocate(ptr);
+				else
+					std::allocator<T>{}.deallocate(ptr, n);
+			}
+
+			template <typename U>
+			inline bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+			template <typename U>
+			inline bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+	};
+}
+
+#endif
@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   slot_map.h                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 22:48:17 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/16 22:48:17 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_SLOT_MAP__
+#define __MLX_SLOT_MAP__
+
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace mlx
+{
+	/**
+	 * Stores objects in stable slots and hands out generation checked handles.
+	 * A handle packs the slot index and the slot generation, so validating one
+	 * is an index plus a compare. Erasing an object bumps the generation of its
+	 * slot which makes every handle still pointing to it stale.
+	 * Objects never move in memory while they are alive.
+	 */
+	template <typename T>
+	class SlotMap
+	{
+		public:
+			using Handle = std::uintptr_t;
+
+			SlotMap() = default;
+
+			template <typename... Args>
+			inline Handle emplace(Args&&... args)
+			{
+				std::uint32_t index = nextIndex();
+				if(index == _slots.size())
+					_slots.emplace_back();
+				else
+					_free.pop_back();
+				Slot& slot = _slots[index];
+				slot.value.emplace(std::forward<Args>(args)...);
+				_size++;
+				return makeHandle(index, slot.generation);
+			}
+
+			// Index the next emplace will use
+			inline std::uint32_t nextIndex() const noexcept { return _free.empty() ? static_cast<std::uint32_t>(_slots.size()) : _free.back(); }
+
+			inline T* get(Handle handle) noexcept
+			{
+				Slot* slot = getSlot(handle);
+				return slot == nullptr ? nullptr : &*slot->value;
+			}
+
+			inline T* get(const void* handle) noexcept { return get(reinterpret_cast<Handle>(handle)); }
+
+			inline const T* get(Handle handle) const noexcept { return const_cast<SlotMap*>(this)->get(handle); }
+			inline const T* get(const void* handle) const noexcept { return get(reinterpret_cast<Handle>(handle)); }
+
+			inline bool erase(Handle handle)
+			{
+				Slot* slot = getSlot(handle);
+				if(slot == nullptr)
+					return false;
+				slot->value.reset();
+				slot->generation = (slot->generation + 1) & GENERATION_MASK;
+				_free.push_back(getIndex(handle));
+				_size--;
+				return true;
+			}
+
+			inline bool erase(const void* handle) { return erase(reinterpret_cast<Handle>(handle)); }
+
+			template <typename F>
+			inline void forEach(F&& f)
+			{
+				for(Slot& slot : _slots)
+				{
+					if(slot.value.has_value())
+						f(*slot.value);
+				}
+			}
+
+			inline std::size_t size() const noexcept { return _size; }
+
+			inline void clear()
+			{
+				_slots.clear();
+				_free.clear();
+				_size = 0;
+			}
+
+			inline static void* toPointer(Handle handle) noexcept { return reinterpret_cast<void*>(handle); }
+
+			~SlotMap() = default;
+
+		private:
+			struct Slot
+			{
+				std::optional<T> value;
+				Handle generation = 0;
+			};
+
+			static constexpr unsigned int INDEX_BITS = sizeof(Handle) * 4;
+			static constexpr Handle INDEX_MASK = (static_cast<Handle>(1) << INDEX_BITS) - 1;
+			static constexpr Handle GENERATION_MASK = INDEX_MASK;
+
+			// index is stored with an offset of one so a valid handle is never NULL
+			inline static Handle makeHandle(std::uint32_t index, Handle generation) noexcept { return (generation << INDEX_BITS) | ((static_cast<Handle>(index) + 1) & INDEX_MASK); }
+			inline static std::uint32_t getIndex(Handle handle) noexcept { return static_cast<std::uint32_t>((handle & INDEX_MASK) - 1); }
+			inline static Handle getGeneration(Handle handle) noexcept { return handle >> INDEX_BITS; }
+
+			inline Slot* getSlot(Handle handle) noexcept
+			{
+				if((handle & INDEX_MASK) == 0)
+					return nullptr;
+				std::uint32_t index = getIndex(handle);
+				if(index >= _slots.size())
+					return nullptr;
+				Slot& slot = _slots[index];
+				if(!slot.value.has_value() || slot.generation != getGeneration(handle))
+					return nullptr;
+				return &slot;
+			}
+
+		private:
+			std::deque<Slot> _slots; // deque keeps references valid on growth
+			std::vector<std::uint32_t> _free;
+			std::size_t _size = 0;
+	};
+}
+
+#endif // __MLX_SLOT_MAP__
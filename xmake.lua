@@ -81,3 +81,15 @@ target("Test")
 
 	add_packages("libsdl")
 target_end()
+
+target("bench")
+	set_default(false)
+	set_kind("binary")
+	set_targetdir("bench")
+
+	add_linkdirs("./")
+
+	add_deps("mlx")
+
+	add_files("bench/main.cpp")
+target_end()